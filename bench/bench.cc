@@ -0,0 +1,323 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "chip8.hh"
+#include "engine.hh"
+#include "expand.hh"
+#include "headless.hh"
+
+// Benchmark suite - no window, no SDL. Runs generated ROMs that each lean on
+// one part of the machine through every engine, then times single calls into
+// the core. Each measurement is repeated & reported as mean ns per op with
+// its spread; --json writes the same numbers out for tracking over time.
+//
+// usage: chip8-bench [--reps N] [--insts N] [--filter S] [--json F]
+
+namespace {
+
+//////////////////////////////////////////////////
+//                Generated ROMs                //
+//////////////////////////////////////////////////
+
+struct Rom {
+    char const* name;
+    std::vector<uint16_t> code;     // loaded at 0x200, every one loops forever
+};
+
+std::vector<Rom> generated_roms() {
+    return {
+        {"alu", {           // 8XYn register arithmetic
+            0x6001,     // 200  V0 = 1
+            0x6105,     // 202  V1 = 5
+            0x6203,     // 204  V2 = 3
+            0x8014,     // 206  loop: V0 += V1
+            0x8124,     // 208  V1 += V2
+            0x8235,     // 20A  V2 -= V3
+            0x8306,     // 20C  V3 = V0 >> 1
+            0x8417,     // 20E  V4 = V1 - V4
+            0x851E,     // 210  V5 = V1 << 1
+            0x8602,     // 212  V6 &= V0
+            0x8711,     // 214  V7 |= V1
+            0x8823,     // 216  V8 ^= V2
+            0x8940,     // 218  V9 = V4
+            0x7A01,     // 21A  VA += 1
+            0x1206,     // 21C  goto loop
+        }},
+        {"sprites", {       // DXYN storm over the font
+            0x6000,     // 200  V0 = 0
+            0x6100,     // 202  V1 = 0
+            0x6200,     // 204  V2 = 0
+            0xF229,     // 206  loop: I = font(V2)
+            0xD015,     // 208  draw 5 rows at V0, V1
+            0x7007,     // 20A  V0 += 7
+            0x7103,     // 20C  V1 += 3
+            0xD01F,     // 20E  draw 15 rows at V0, V1
+            0x7201,     // 210  V2 += 1
+            0x1206,     // 212  goto loop
+        }},
+        {"memory", {        // FX55 / FX65 churn over 2 KB
+            0xA300,     // 200  I = 300
+            0xFF55,     // 202  loop: dump V0-VF
+            0xFF65,     // 204  load V0-VF
+            0x6A10,     // 206  VA = 16
+            0xFA1E,     // 208  I += VA
+            0x7B01,     // 20A  VB += 1
+            0x3B80,     // 20C  skip if VB == 80
+            0x1202,     // 20E  goto loop
+            0x6B00,     // 210  VB = 0
+            0x1200,     // 212  start over at 300
+        }},
+        {"calls", {         // call / return chains five deep
+            0x2210,     // 200  loop: call 210
+            0x1200,     // 202  goto loop
+            0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+            0x7001,     // 210  V0 += 1
+            0x2220,     // 212  call 220
+            0x00EE,     // 214  return
+            0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+            0x7101,     // 220  V1 += 1
+            0x2230,     // 222  call 230
+            0x00EE,     // 224  return
+            0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+            0x7201,     // 230  V2 += 1
+            0x2240,     // 232  call 240
+            0x00EE,     // 234  return
+            0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+            0x7301,     // 240  V3 += 1
+            0x2250,     // 242  call 250
+            0x00EE,     // 244  return
+            0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+            0x7401,     // 250  V4 += 1
+            0x00EE,     // 252  return
+        }},
+    };
+}
+
+std::vector<uint8_t> rom_bytes(const Rom& rom) {
+    std::vector<uint8_t> bytes;
+    for (uint16_t inst : rom.code) {
+        bytes.push_back(inst >> 8);
+        bytes.push_back(inst & 0xFF);
+    }
+    return bytes;
+}
+
+
+//////////////////////////////////////////////////
+//                    Timing                    //
+//////////////////////////////////////////////////
+
+struct Result {
+    std::string name;
+    std::string engine;     // empty for microbenchmarks
+    std::vector<double> ns_per_op;
+
+    double mean() const {
+        double sum = 0;
+        for (double ns : ns_per_op)
+            sum += ns;
+        return sum / ns_per_op.size();
+    }
+
+    double stddev() const {
+        double m = mean(), sum = 0;
+        for (double ns : ns_per_op)
+            sum += (ns - m) * (ns - m);
+        return ns_per_op.size() > 1 ? std::sqrt(sum / (ns_per_op.size() - 1)) : 0.0;
+    }
+};
+
+// one untimed warm up, then reps timed runs of op count ops each
+Result measure(std::string name, std::string engine, int reps, uint64_t ops, const std::function<void()>& run) {
+    Result result{std::move(name), std::move(engine), {}};
+    run();
+    for (int r=0; r<reps; r++) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        result.ns_per_op.push_back(elapsed.count() / ops);
+    }
+    return result;
+}
+
+void print_result(const Result& r) {
+    double mean = r.mean();
+    std::printf("%-16s %-9s %10.2f ns/op  %12.0f op/s   +- %5.2f%%   (min %.2f, max %.2f)\n",
+                r.name.c_str(), r.engine.empty() ? "-" : r.engine.c_str(), mean, 1e9 / mean,
+                100.0 * r.stddev() / mean,
+                *std::min_element(r.ns_per_op.begin(), r.ns_per_op.end()),
+                *std::max_element(r.ns_per_op.begin(), r.ns_per_op.end()));
+}
+
+bool write_json(char const* path, const std::vector<Result>& results) {
+    std::FILE* out = std::fopen(path, "w");
+    if (!out)
+        return false;
+
+    std::fprintf(out, "{\"benchmarks\":[\n");
+    for (size_t i=0; i<results.size(); i++) {
+        const Result& r = results[i];
+        std::fprintf(out, "  {\"name\":\"%s\",", r.name.c_str());
+        if (!r.engine.empty())
+            std::fprintf(out, "\"engine\":\"%s\",", r.engine.c_str());
+        std::fprintf(out, "\"ns_per_op\":%.4f,\"ops_per_sec\":%.1f,\"stddev_ns\":%.4f,\"samples\":[",
+                     r.mean(), 1e9 / r.mean(), r.stddev());
+        for (size_t s=0; s<r.ns_per_op.size(); s++)
+            std::fprintf(out, "%s%.4f", s ? "," : "", r.ns_per_op[s]);
+        std::fprintf(out, "]}%s\n", (i + 1 < results.size()) ? "," : "");
+    }
+    std::fprintf(out, "]}\n");
+
+    return std::fclose(out) == 0;
+}
+
+}
+
+int main(int argc, char ** argv) {
+    int reps = 7;
+    uint64_t insts = 20000000;
+    char const* filter = "";
+    char const* json_path = nullptr;
+
+    for (int i=1; i<argc; i++) {
+        if (!std::strcmp(argv[i], "--reps") && i+1 < argc) {
+            reps = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (!std::strcmp(argv[i], "--insts") && i+1 < argc) {
+            insts = std::max<uint64_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (!std::strcmp(argv[i], "--filter") && i+1 < argc) {
+            filter = argv[++i];
+        }
+        else if (!std::strcmp(argv[i], "--json") && i+1 < argc) {
+            json_path = argv[++i];
+        }
+        else {
+            std::fprintf(stderr, "usage: %s [--reps N] [--insts N] [--filter S] [--json F]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<char const*> engines = {"switch", "dispatch"};
+#ifdef CHIP8_JIT
+    engines.push_back("jit");
+#endif
+
+    std::vector<Result> results;
+    auto wanted = [&](const std::string& name) {
+        return name.find(filter) != std::string::npos;
+    };
+    auto report = [&](Result r) {
+        print_result(r);
+        results.push_back(std::move(r));
+    };
+
+    // whole ROMs through each engine - per instruction
+    for (const Rom& rom : generated_roms()) {
+        std::string name = std::string("rom/") + rom.name;
+        if (!wanted(name))
+            continue;
+
+        std::vector<uint8_t> bytes = rom_bytes(rom);
+        for (char const* engine_name : engines) {
+            Chip8 chip8(bytes);
+            HeadlessFrontend io{};
+            std::unique_ptr<Engine> engine = make_engine(engine_name, chip8, io);
+
+            report(measure(name, engine_name, reps, insts, [&] {
+                engine->run(insts);
+            }));
+        }
+    }
+
+    // single calls into the core - per call
+    volatile uint32_t sink = 0;
+
+    if (wanted("micro/draw")) {
+        Chip8 chip8(std::span<const uint8_t>{});
+        chip8.set_index(0x50);
+        uint64_t const calls = 4000000;
+        report(measure("micro/draw", "", reps, calls, [&] {
+            for (uint64_t i=0; i<calls; i++) {
+                chip8.set_reg_const(0, uint8_t(i * 7));
+                chip8.set_reg_const(1, uint8_t(i * 3));
+                chip8.draw(0, 1, 5);
+            }
+            sink = sink + chip8.get_var_reg(0xF);
+        }));
+    }
+
+    if (wanted("micro/get_inst")) {
+        std::vector<uint8_t> bytes = rom_bytes(generated_roms()[0]);
+        Chip8 chip8(bytes);
+        uint64_t const calls = 20000000;
+        report(measure("micro/get_inst", "", reps, calls, [&] {
+            uint32_t acc = 0;
+            for (uint64_t i=0; i<calls; i++) {
+                acc += chip8.get_inst();
+                if ((i & 1023) == 1023)
+                    chip8.jump(0x200);
+            }
+            chip8.jump(0x200);
+            sink = sink + acc;
+        }));
+    }
+
+    // what WindowHandler::draw_pixels does with the display before upload
+    struct Size { char const* name; size_t width, rows; };
+    for (Size size : {Size{"micro/expand64", 64, 32}, Size{"micro/expand128", 128, 64}}) {
+        if (!wanted(size.name))
+            continue;
+
+        std::vector<uint64_t> words(size.rows * size.width / 64, 0xA5A5F00F0FF05A5A);
+        std::vector<uint32_t> pixels(size.rows * size.width);
+        uint64_t const frames = 50000;
+        report(measure(size.name, expand_kernel_name(expand_kernel_best()), reps, frames, [&] {
+            for (uint64_t f=0; f<frames; f++)
+                expand_rows(words.data(), size.width, size.rows, pixels.data(), Palette{});
+            sink = sink + pixels.back();
+        }));
+    }
+
+    if (json_path && !write_json(json_path, results)) {
+        std::fprintf(stderr, "error: could not write %s\n", json_path);
+        return 1;
+    }
+    return 0;
+}
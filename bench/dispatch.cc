@@ -0,0 +1,123 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "chip8.hh"
+#include "engine.hh"
+#include "headless.hh"
+
+// Instructions per second of each engine over the same ROM. With no argument
+// a synthetic ALU / call / memory loop is used (no draws, no rand, no input),
+// otherwise the given .ch8 file.
+
+static std::filesystem::path synthetic_rom() {
+    std::vector<uint16_t> code = {
+        0x6000,     // 200  V0 = 0
+        0x6105,     // 202  V1 = 5
+        0xA300,     // 204  I = 300
+        0x7001,     // 206  loop: V0 += 1
+        0x8014,     // 208  V0 += V1
+        0x8206,     // 20A  V2 = V0 >> 1
+        0x8305,     // 20C  V3 -= V0
+        0x830E,     // 20E  V3 <<= 1
+        0x8417,     // 210  V4 = V1 - V4
+        0x8512,     // 212  V5 &= V1
+        0x8613,     // 214  V6 ^= V1
+        0x8721,     // 216  V7 |= V2
+        0x2230,     // 218  call 230
+        0xF265,     // 21A  load V0-V2
+        0x3A00,     // 21C  skip if VA == 0
+        0x7A01,     // 21E  VA += 1
+        0x4B10,     // 220  skip if VB != 10
+        0x6B00,     // 222  VB = 0
+        0x7B01,     // 224  VB += 1
+        0x5010,     // 226  skip if V0 == V1
+        0x9010,     // 228  skip if V0 != V1
+        0xF71E,     // 22A  I += V7
+        0xA300,     // 22C  I = 300
+        0x1206,     // 22E  goto loop
+        0x7C03,     // 230  VC += 3
+        0x8CC4,     // 232  VC += VC
+        0xF355,     // 234  dump V0-V3
+        0x00EE,     // 236  return
+    };
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "chip8-bench-dispatch.ch8";
+    std::ofstream out(path, std::ios::binary);
+    for (uint16_t inst : code) {
+        out.put(char(inst >> 8));
+        out.put(char(inst & 0xFF));
+    }
+    return path;
+}
+
+static double measure(char const* engine_name, std::filesystem::path const& rom, uint64_t insts) {
+    Chip8 chip8(rom);
+    HeadlessFrontend io{};
+    std::unique_ptr<Engine> engine = make_engine(engine_name, chip8, io);
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t executed = engine->run(insts);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return executed / elapsed.count();
+}
+
+int main(int argc, char ** argv) {
+    std::filesystem::path rom = (argc > 1) ? std::filesystem::path{argv[1]} : synthetic_rom();
+    uint64_t insts = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 50000000;
+    int const reps = 5;
+
+    std::vector<char const*> engines = {"switch", "dispatch"};
+#ifdef CHIP8_JIT
+    engines.push_back("jit");
+#endif
+    std::vector<double> best(engines.size());
+
+    for (size_t e=0; e<engines.size(); e++) {
+        std::vector<double> runs;
+        for (int r=0; r<reps; r++)
+            runs.push_back(measure(engines[e], rom, insts));
+        std::sort(runs.begin(), runs.end());
+        best[e] = runs.back();
+        std::printf("%-10s  median %12.0f inst/s   best %12.0f inst/s\n",
+                    engines[e], runs[reps / 2], runs.back());
+    }
+
+    for (size_t e=1; e<engines.size(); e++)
+        std::printf("%-10s  %.2fx over switch\n", engines[e], best[e] / best[0]);
+    return 0;
+}
@@ -0,0 +1,103 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "expand.hh"
+
+// Time per frame of each expansion kernel against the original bit-by-bit
+// loop, at 64x32 and the SUPER-CHIP 128x64 size. Every kernel's output is
+// checked against the original first.
+
+// the expansion WindowHandler::draw_pixels used to do
+static void expand_bitloop(const uint64_t* words, size_t width, size_t rows, uint32_t* out, Palette p) {
+    for (size_t w=0; w<rows * (width / 64); w++) {
+        uint64_t row = words[w];
+        for (uint64_t mask = 0x8000000000000000; mask > 0; mask >>= 1)
+            *(out++) = ((row & mask) > 0) ? p.fg : p.bg;
+    }
+}
+
+template <typename F>
+static double ns_per_frame(F expand, int frames) {
+    auto start = std::chrono::steady_clock::now();
+    for (int f=0; f<frames; f++)
+        expand();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / frames;
+}
+
+int main() {
+    std::mt19937_64 rng{12345};
+    Palette palette{0x33FF66FF, 0x101010FF};
+    int const frames = 20000;
+    int status = 0;
+
+    struct Size { size_t width, rows; };
+    for (Size size : {Size{64, 32}, Size{128, 64}}) {
+        std::vector<uint64_t> words(size.rows * size.width / 64);
+        for (uint64_t& w : words)
+            w = rng();
+
+        std::vector<uint32_t> expected(size.rows * size.width);
+        std::vector<uint32_t> out(expected.size());
+        expand_bitloop(words.data(), size.width, size.rows, expected.data(), palette);
+
+        std::printf("%zux%zu\n", size.width, size.rows);
+        double base = ns_per_frame([&] {
+            expand_bitloop(words.data(), size.width, size.rows, out.data(), palette);
+        }, frames);
+        std::printf("  %-8s %10.1f ns/frame\n", "bitloop", base);
+
+        for (ExpandKernel k : {ExpandKernel::Scalar, ExpandKernel::SSE2, ExpandKernel::AVX2}) {
+            if (!expand_kernel_supported(k))
+                continue;
+
+            std::fill(out.begin(), out.end(), 0);
+            expand_rows_with(k, words.data(), size.width, size.rows, out.data(), palette);
+            if (std::memcmp(out.data(), expected.data(), out.size() * sizeof(uint32_t))) {
+                std::printf("  %-8s output mismatch\n", expand_kernel_name(k));
+                status = 1;
+                continue;
+            }
+
+            double t = ns_per_frame([&] {
+                expand_rows_with(k, words.data(), size.width, size.rows, out.data(), palette);
+            }, frames);
+            std::printf("  %-8s %10.1f ns/frame   %.2fx\n", expand_kernel_name(k), t, base / t);
+        }
+    }
+
+    std::printf("dispatch picks %s\n", expand_kernel_name(expand_kernel_best()));
+    return status;
+}
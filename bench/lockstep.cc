@@ -0,0 +1,253 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#include "chip8.hh"
+#include "cli.hh"
+#include "engine.hh"
+#include "headless.hh"
+#include "lockstep.hh"
+#include "savestate.hh"
+#include "scheduler.hh"
+
+// A population of lanes running one ROM, each fed its own random key presses
+// frame by frame - once through Lockstep, once as separate Chip8s on the
+// dispatch engine. Every lane's final state is checked against its Chip8 before
+// the timings are printed.
+//
+// usage: chip8-bench-lockstep [lanes] [frames] [rom.ch8]
+
+static std::vector<uint8_t> synthetic_rom() {
+    std::vector<uint16_t> code = {
+        0x6000,     // 200  V0 = 0
+        0x6100,     // 202  V1 = 0
+        0xA240,     // 204  I = sprite
+        0xD015,     // 206  loop: erase sprite
+        0xD100,     // 208  erase 16x16 sprite
+        0x6205,     // 20A  V2 = 5
+        0xE2A1,     // 20C  skip if key 5 up
+        0x7001,     // 20E  V0 += 1
+        0x6208,     // 210  V2 = 8
+        0xE2A1,     // 212  skip if key 8 up
+        0x7101,     // 214  V1 += 1
+        0xC307,     // 216  V3 = rand & 7
+        0x8034,     // 218  V0 += V3
+        0xD015,     // 21A  draw sprite
+        0xD100,     // 21C  draw 16x16 sprite
+        0x6500,     // 21E  V5 = 0
+        0x8654,     // 220  inner: V6 += V5
+        0x8763,     // 222  V7 ^= V6
+        0x8876,     // 224  V8 = V7 >> 1
+        0x8984,     // 226  V9 += V8
+        0x8A95,     // 228  VA -= V9
+        0x7501,     // 22A  V5 += 1
+        0x3520,     // 22C  skip if V5 == 20
+        0x1220,     // 22E  goto inner
+        0xA300,     // 230  I = 300
+        0xF933,     // 232  bcd V9
+        0xF265,     // 234  load V0-V2
+        0xA240,     // 236  I = sprite
+        0x1206,     // 238  goto loop
+        0x0000, 0x0000, 0x0000,
+        0xF090,     // 240  sprite, & the top of the 16x16 one
+        0xF090,
+        0xF000,
+        0x3C3C, 0x7E7E, 0xFFFF, 0x8181,
+        0x8181, 0xFFFF, 0x7E7E, 0x3C3C,
+        0x1818, 0x2424, 0x4242, 0x8181,
+        0xFF00,
+    };
+
+    std::vector<uint8_t> rom;
+    for (uint16_t inst : code) {
+        rom.push_back(inst >> 8);
+        rom.push_back(inst & 0xFF);
+    }
+    return rom;
+}
+
+// the first field two states disagree on, roughly in the order a divergence
+// shows up - what gets drawn, then the flag, then the rest
+static void describe_difference(const SaveState& a, const SaveState& b, char* out, size_t size) {
+    for (size_t w=0; w<a.display.size(); w++) {
+        if (a.display[w] != b.display[w]) {
+            std::snprintf(out, size, "display row %zu (plane %zu word %zu) %016llX vs %016llX",
+                          w / 2 % 64, w / 128 + 1, w % 2,
+                          (unsigned long long)a.display[w], (unsigned long long)b.display[w]);
+            return;
+        }
+    }
+    if (a.var_regs[0xF] != b.var_regs[0xF]) {
+        std::snprintf(out, size, "VF %02X vs %02X", a.var_regs[0xF], b.var_regs[0xF]);
+        return;
+    }
+    if (a.index_register != b.index_register) {
+        std::snprintf(out, size, "I %03X vs %03X", a.index_register, b.index_register);
+        return;
+    }
+    if (a.program_counter != b.program_counter) {
+        std::snprintf(out, size, "pc %03X vs %03X", a.program_counter, b.program_counter);
+        return;
+    }
+    for (int r=0; r<15; r++) {
+        if (a.var_regs[r] != b.var_regs[r]) {
+            std::snprintf(out, size, "V%X %02X vs %02X", r, a.var_regs[r], b.var_regs[r]);
+            return;
+        }
+    }
+    for (size_t m=0; m<a.memory.size(); m++) {
+        if (a.memory[m] != b.memory[m]) {
+            std::snprintf(out, size, "memory %03zX %02X vs %02X", m, a.memory[m], b.memory[m]);
+            return;
+        }
+    }
+    if (a.stack_pointer != b.stack_pointer || a.stack != b.stack) {
+        std::snprintf(out, size, "stack (depth %d vs %d)", a.stack_pointer, b.stack_pointer);
+        return;
+    }
+    if (a.delay_timer != b.delay_timer || a.sound_timer != b.sound_timer) {
+        std::snprintf(out, size, "timers dt %02X st %02X vs dt %02X st %02X",
+                      a.delay_timer, a.sound_timer, b.delay_timer, b.sound_timer);
+        return;
+    }
+    if (a.rng_state != b.rng_state) {
+        std::snprintf(out, size, "random state");
+        return;
+    }
+    std::snprintf(out, size, "key wait / configuration");
+}
+
+// key presses for lane l in frame f - any pattern will do as long as both
+// runs see the same one
+static uint16_t lane_keys(size_t lane, uint64_t frame) {
+    uint64_t h = (lane + 1) * 0x9E3779B97F4A7C15 ^ (frame + 1) * 0xBF58476D1CE4E5B9;
+    h ^= h >> 31;
+    h *= 0x94D049BB133111EB;
+    h ^= h >> 29;
+    return uint16_t(h) & uint16_t(h >> 16);
+}
+
+int main(int argc, char ** argv) {
+    uint64_t lanes = 256;
+    uint64_t frames = 600;
+    if (argc > 4 || (argc > 1 && !parse_count(argv[1], lanes)) || (argc > 2 && !parse_count(argv[2], frames))) {
+        std::fprintf(stderr, "usage: %s [lanes] [frames] [rom.ch8]\n", argv[0]);
+        return 1;
+    }
+    if (argc > 3 && !std::filesystem::exists(argv[3])) {
+        std::fprintf(stderr, "error: %s does not exist\n", argv[3]);
+        return 1;
+    }
+    std::vector<uint8_t> rom = (argc > 3) ? read_rom_file(argv[3]) : synthetic_rom();
+
+    Chip8 start(rom);
+    start.config_shift(false);
+    start.config_jump_offset(false);
+    start.config_store_load_inc(false);
+    start.config_timing(60000);     // 1000 instructions a frame
+
+    SaveState state;
+    start.save(state);
+
+    // lockstep
+    Lockstep lockstep(state, lanes);
+    for (size_t l=0; l<lanes; l++)
+        lockstep.seed_rand(l, l);
+
+    uint64_t lockstep_insts = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (uint64_t f=0; f<frames; f++) {
+        for (size_t l=0; l<lanes; l++)
+            lockstep.set_keys(l, lane_keys(l, f));
+        lockstep_insts += lockstep.run_frame();
+    }
+    std::chrono::duration<double> lockstep_time = std::chrono::steady_clock::now() - begin;
+
+    // one machine at a time
+    uint64_t single_insts = 0;
+    int mismatches = 0;
+    int unsupported = 0;
+    std::chrono::duration<double> single_time{0};
+    for (size_t l=0; l<lanes; l++) {
+        Chip8 chip8 = start.clone();
+        chip8.seed_rand(l);
+        HeadlessFrontend io{};
+        std::unique_ptr<Engine> engine = make_engine("dispatch", chip8, io);
+        Scheduler scheduler(chip8, *engine, io);
+
+        begin = std::chrono::steady_clock::now();
+        for (uint64_t f=0; f<frames; f++) {
+            io.set_keys(lane_keys(l, f));
+            single_insts += scheduler.run_frame();
+        }
+        single_time += std::chrono::steady_clock::now() - begin;
+
+        // a halted lane can't match, it's reported instead
+        if (lockstep.is_unsupported(l)) {
+            if (unsupported++ < 5)
+                std::printf("UNSUPPORTED lane %zu: stopped on %03X\n", l, lockstep.get_pc(l));
+            continue;
+        }
+
+        SaveState expect, got;
+        chip8.save(expect);
+        lockstep.save_lane(l, got);
+        if (std::memcmp(&expect, &got, sizeof(SaveState)) != 0) {
+            if (mismatches++ < 5) {
+                char what[96];
+                describe_difference(expect, got, what, sizeof(what));
+                std::printf("MISMATCH lane %zu: %s\n", l, what);
+            }
+        }
+    }
+
+    // instruction totals only line up when every lane ran to the end
+    if (mismatches || (!unsupported && single_insts != lockstep_insts)) {
+        std::printf("%d lanes differ, %llu vs %llu instructions\n", mismatches,
+                    (unsigned long long)lockstep_insts, (unsigned long long)single_insts);
+        return 1;
+    }
+
+    if (unsupported)
+        std::printf("%d lanes stopped on instructions lanes can't run (00FF, FN01), not compared\n", unsupported);
+    std::printf("%llu lanes x %llu frames, %s lanes match\n", (unsigned long long)lanes,
+                (unsigned long long)frames, unsupported ? "all other" : "all");
+    if (unsupported)
+        return 0;   // halted lanes stop early, so the timings don't compare
+    std::printf("lockstep   %12.0f inst/s   %.1f lanes per step\n",
+                lockstep_insts / lockstep_time.count(), lockstep.get_occupancy());
+    std::printf("dispatch   %12.0f inst/s\n", single_insts / single_time.count());
+    std::printf("lockstep   %.2fx over dispatch\n", single_time.count() / lockstep_time.count());
+    return 0;
+}
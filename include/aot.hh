@@ -0,0 +1,103 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <span>
+
+#include "chip8.hh"
+#include "dispatch.hh"
+#include "engine.hh"
+#include "frontend.hh"
+
+// What a recompiled block works on - V0-VF & I directly, and the Chip8 &
+// Frontend for everything it hands off to their member functions
+struct AotState {
+    Chip8& chip8;
+    Frontend& io;
+    uint8_t* v;
+    uint16_t& index;
+};
+
+// recompiled block - runs every instruction in it, returns the next program counter
+using AotCode = uint16_t (*)(AotState&);
+
+struct AotBlock {
+    uint16_t start;
+    uint16_t len;       // instructions
+    AotCode code;
+};
+
+// A ROM as chip8-aot recompiled it: one function per basic block, compiled
+// for one set of quirks, plus the image the blocks were made from
+struct AotProgram {
+    char const* name;
+    uint8_t quirks;                     // Quirks::bits layout
+    std::span<const uint8_t> image;     // ROM bytes, loaded at 0x200
+    std::span<const AotBlock> blocks;   // sorted by start
+};
+
+// the program a runner was built around, defined by the generated file
+extern const AotProgram aot_program;
+
+// Runs a program recompiled ahead of time by chip8-aot. A block runs as
+// native code whenever the program counter lands on its start, it fits in
+// what's left of the budget & its bytes in memory are still the ones it was
+// compiled from. Everything else goes through the Dispatcher: computed jumps
+// (BNNN) into code the recompiler never found, FX0A, blocks the program has
+// overwritten, a different ROM, & any quirks other than the program's.
+class AotEngine : public Engine, public MemoryWatcher {
+    Chip8& chip8;
+    Frontend& io;
+    Dispatcher fallback;
+    const AotProgram& program;
+
+    // index into program.blocks for each start address, -1 if none or stale
+    std::array<int32_t, 4096> block_at;
+
+    // bytes covered by at least one block, live or not
+    std::bitset<4096> code_bytes;
+
+#ifdef CHIP8_STATS
+    // stat_slot() of each recompiled instruction, by address
+    std::array<uint8_t, 4096> stat_at;
+#endif
+
+    // check blocks overlapping addresses first - last against memory
+    void verify(int, int);
+
+public:
+    AotEngine(Chip8&, Frontend&, const AotProgram&);
+    ~AotEngine();
+
+    uint64_t run(uint64_t) override;
+    void on_write(uint16_t, uint16_t) override;
+};
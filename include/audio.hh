@@ -0,0 +1,60 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <array>
+
+#include "SDL3/SDL_audio.h"
+
+#include "beeper.hh"
+
+// Plays a Beeper through an SDL3 audio stream. SDL's audio thread pulls
+// samples through the stream callback; the emulation thread only ever
+// touches the Beeper's edge ring, so audio can't hold up the instruction loop.
+class AudioOutput {
+    static constexpr int sample_rate = 48000;
+
+    SDL_AudioStream* stream;
+    Beeper beeper;
+    std::array<float, 1024> scratch;    // audio thread only
+
+    static void SDLCALL feed(void*, SDL_AudioStream*, int, int);
+
+public:
+    // buffer - device buffer in sample frames, 256 is ~5 ms at 48 kHz,
+    //          anything up to 960 stays under 20 ms; 0 - no audio at all
+    AudioOutput(int);
+    ~AudioOutput();
+
+    AudioOutput(const AudioOutput&) = delete;
+    AudioOutput& operator=(const AudioOutput&) = delete;
+
+    // nullptr if there's no audio device (or it was turned off)
+    Beeper* get_beeper();
+};
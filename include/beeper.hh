@@ -0,0 +1,89 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "spsc_ring.hh"
+
+// Beeper on / off edge, stamped with the frame that ended in that state
+struct BeeperEdge {
+    uint64_t frame;
+    bool on;
+};
+
+// The sound timer as audio. The emulation thread queues an edge whenever the
+// beeper turns on or off, through a lock-free ring, so it never waits on the
+// audio side. The audio side renders a band-limited square wave from a
+// precomputed one-period table, with a short raised cosine fade at each edge
+// so turning on & off doesn't click.
+//
+// Edges are placed by frame number: frame f starts f * rate / 60 samples
+// after an origin fixed by the first edge, one latency later than it showed
+// up. If emulation & audio drift too far apart (a stall, rewinding) the
+// origin is reset the same way.
+class Beeper {
+    static constexpr size_t table_size = 2048;
+
+    SpscRing<BeeperEdge, 256> edges;
+    bool sent;          // producer - state of the last edge queued
+
+    // everything below is the consumer's
+    int sample_rate;
+    int64_t latency;    // samples between an edge arriving & being heard
+    float volume;
+
+    std::vector<float> wave;    // one period, table_size + 1 entries for interpolation
+    std::vector<float> ramp;    // 0 -> 1 raised cosine
+    double phase;               // 0 - 1 through the period
+    double phase_step;
+
+    int64_t clock;      // samples rendered so far
+    int64_t origin;     // sample frame 0 started at
+    bool anchored;
+    bool on;
+    size_t env;         // index into ramp, climbs while on & falls while off
+
+    int64_t due(uint64_t);
+    void synth(float*, size_t);
+
+public:
+    // sample_rate - Hz,  latency - samples, about one audio buffer
+    // tone - Hz,  volume - peak amplitude, 0 - 1
+    Beeper(int, int, float = 440.0f, float = 0.25f);
+
+    // emulation thread - state of the beeper at the end of frame
+    // only changes are queued, an edge that doesn't fit goes on the next call
+    void update(uint64_t, bool);
+
+    // audio thread - fill in n mono samples
+    void render(float*, size_t);
+};
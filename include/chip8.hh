@@ -31,13 +31,52 @@ freely, subject to the following restrictions:
 #include <cstdint>
 #include <array>
 #include <filesystem>
-#include <stack>
+#include <span>
 #include <string>
+#include <vector>
+
+#include "display.hh"
+#include "quirks.hh"
+
+struct SaveState;
+
+// the bytes of a ROM file, anything that wouldn't fit from 0x200 on left out
+std::vector<uint8_t> read_rom_file(const std::filesystem::path&);
+
+// Notified whenever the running program writes to its own memory (FX33, FX55),
+// so anything caching decoded code can drop what was overwritten
+class MemoryWatcher {
+public:
+    virtual ~MemoryWatcher() = default;
+
+    // addr - first byte written,  len - number of bytes written
+    virtual void on_write(uint16_t, uint16_t) = 0;
+};
+
+// Notified of every subroutine call & return that goes through (not on stack
+// overflow / underflow), e.g. to rebuild the program's call graph
+class CallWatcher {
+public:
+    virtual ~CallWatcher() = default;
+
+    // from - address of the 2NNN,  to - NNN
+    virtual void on_call(uint16_t, uint16_t) = 0;
+
+    // to - address returned to
+    virtual void on_return(uint16_t) = 0;
+};
 
 class Chip8 {
+    friend class Dispatcher;
+    friend class Jit;
+    friend class Profiler;
+    friend class AotEngine;
+
 private:
-    // display  -  64 * 32 pixels
-    std::array<uint64_t, 32> display;
+    // display  -  64 * 32 pixels, or 128 * 64 in hires, on up to two planes
+    Screen display;
+    uint64_t dirty_rows;    // bit n set - row n changed since last take_dirty_rows()
+    uint8_t plane_mask;     // planes drawn, cleared & scrolled - bit 0 plane 1, bit 1 plane 2
 
     // memory, registers, & counter
     std::array<uint8_t, 4096> memory;
@@ -49,56 +88,106 @@ private:
     uint8_t delay_timer;
     uint8_t sound_timer;
 
-    // stack
-    std::stack<uint16_t> stack;
+    // stack  -  16 return addresses
+    std::array<uint16_t, 16> stack;
+    uint8_t stack_pointer;
 
-    // configuration
+    // configuration - quirks default to off, see quirks.hh
     int inst_per_sec;
     bool shift_use_vy;
     bool jump_offset_vx;
     bool store_load_i_inc;
 
+    // CXNN random source - xorshift64*, one per machine so instances running
+    // side by side never share hidden state & every run is reproducible
+    uint64_t rng_state;
+
+    MemoryWatcher* watcher;
+    CallWatcher* call_watcher;
+
+    // tell the watcher about len bytes written from addr, wrapping past 0xFFF
+    void notify_write(uint16_t, uint16_t);
+
 public:
     Chip8(std::filesystem::path);
+    Chip8(std::span<const uint8_t>);     // rom image, loaded at 0x200
+
+    // fork the running machine - everything is copied (memory, display,
+    // registers, stack, timers, configuration) except the MemoryWatcher &
+    // CallWatcher, which stay with whatever is attached to each machine
+    Chip8 clone() const;
+    void clone_into(Chip8&) const;      // into existing storage, no allocation
 
     // 0 - not blocked,  1 - blocked,  2 - recognized key down (still blocked) awaiting matching key up
     int block_state;
 
     // access
-    std::array<uint64_t, 32> get_display();
+    const Screen& get_display();
+    uint64_t take_dirty_rows();
     bool end_of_mem();
     uint16_t get_inst();
     void decrement_pc();
     void increment_pc();
     int get_timing();
+    void tick_timers();
     //
     uint8_t get_var_reg(uint8_t);
+    uint16_t get_index();
+    uint16_t get_pc();
+    uint8_t get_stack_depth();
+    uint8_t get_delay_timer();
+    uint8_t get_sound_timer();
+    void watch_memory(MemoryWatcher*);
+    void watch_calls(CallWatcher*);
+
 
+    // save states - the whole machine, see savestate.hh
+    void save(SaveState&);
+    int  load(const SaveState&);   // 1 - wrong magic / version, nothing changed
 
     // chip 8 configuration
     void config_timing(int);
     void config_shift(bool);
     void config_jump_offset(bool);
     void config_store_load_inc(bool);
+    void config_quirks(QuirkProfile);
+    void config_quirk_bits(uint8_t);    // Quirks::bits layout
+    uint8_t get_quirks();       // Quirks::bits layout
+    void seed_rand(uint64_t);
+    static uint64_t mix_seed(uint64_t);     // seed -> generator state, never 0
 
 /****************/
 /*   display    */
 /****************/
     
     
+    // 00E0 - clears the selected planes
     void disp_clear();
     
     // DXYN : Display instruction - draws a sprite to the screen
     // x - register number that holds the X coordinate
     // y - register number that holds the Y coordinate
-    // n - number of rows the sprite takes up (1 to 16 rows, represented with 0-15)
+    // n - number of rows the sprite takes up (1 to 15), 0 for a 16x16 sprite
+    // with both planes selected, plane 2's sprite follows plane 1's in memory
     void draw(uint8_t, uint8_t, uint8_t);
 
+    // SUPER-CHIP / XO-CHIP - scrolls move the selected planes, in pixels of
+    // the current resolution
+    void scroll_down(uint8_t);      // 00CN
+    void scroll_up(uint8_t);        // 00DN
+    void scroll_right();            // 00FB - 4 pixels
+    void scroll_left();             // 00FC - 4 pixels
+    void exit_program();            // 00FD - stays on the 00FD from then on
+    void set_hires(bool);           // 00FE / 00FF - clears both planes
+    void select_planes(uint8_t);    // FN01
+    void big_sprite_index(uint8_t); // FX30 - 8x10 digit
+
 /****************/
 /*     flow     */
 /****************/
     void jump(uint16_t);
     void jump_offset(uint16_t);
+    template <typename Q> void jump_offset(uint16_t);
     int  subroutine_call(uint16_t);
     int  subroutine_return();
 
@@ -121,6 +210,8 @@ public:
     void bitwise_xor(uint8_t, uint8_t);
     void bitwise_shift_right(uint8_t, uint8_t);
     void bitwise_shift_left(uint8_t, uint8_t);
+    template <typename Q> void bitwise_shift_right(uint8_t, uint8_t);
+    template <typename Q> void bitwise_shift_left(uint8_t, uint8_t);
 
     // math
     void add(uint8_t, uint8_t);
@@ -133,6 +224,8 @@ public:
     void sprite_index(uint8_t);
     void reg_dump(uint8_t);
     void reg_load(uint8_t);
+    template <typename Q> void reg_dump(uint8_t);
+    template <typename Q> void reg_load(uint8_t);
 
     // rand
     void gen_rand(uint8_t, uint8_t);
@@ -152,4 +245,70 @@ public:
     // bcd
     void bcd(uint8_t);
 
-};
\ No newline at end of file
+};
+
+
+/****************/
+/*    quirks    */
+/****************/
+
+// The quirk dependent instructions, specialised on a Quirks policy so the
+// quirk is settled at compile time. The untemplated versions go by the
+// machine's own flags.
+
+// BNNN : Jump with offset
+template <typename Q>
+void Chip8::jump_offset(uint16_t n) {
+    int x = Q::jump_offset_vx ? (n & 0xF00) >> 8 : 0;
+    program_counter = n + var_regs[x];
+}
+
+// 8XY6
+template <typename Q>
+void Chip8::bitwise_shift_right(uint8_t x, uint8_t y) {
+    if constexpr (Q::shift_use_vy)
+        var_regs[x] = var_regs[y];
+
+    uint8_t flag = var_regs[x] & 0x01;
+    var_regs[x] >>= 1;
+    var_regs[0xF] = flag;
+}
+
+// 8XYE
+template <typename Q>
+void Chip8::bitwise_shift_left(uint8_t x, uint8_t y) {
+    if constexpr (Q::shift_use_vy)
+        var_regs[x] = var_regs[y];
+
+    uint8_t flag = (var_regs[x] & 0x80) >> 7;
+    var_regs[x] <<= 1;
+    var_regs[0xF] = flag;
+}
+
+// FX55 : register dump V0-Vx into memory, starting at location I - addresses
+// wrap to 12 bits
+template <typename Q>
+void Chip8::reg_dump(uint8_t x) {
+    for (int i=0; i<=x; i++) {
+        memory[(index_register+i) & 0xFFF] = var_regs[i];
+    }
+
+    notify_write(index_register, x + 1);
+
+    if constexpr (Q::store_load_i_inc) {
+        index_register += x + 1;
+    }
+}
+
+// FX65 : register load V0-Vx from memory, starting at location I - addresses
+// wrap to 12 bits
+template <typename Q>
+void Chip8::reg_load(uint8_t x) {
+    for (int i=0; i<=x; i++) {
+        var_regs[i] = memory[(index_register+i) & 0xFFF];
+    }
+
+    if constexpr (Q::store_load_i_inc) {
+        index_register += x + 1;
+    }
+}
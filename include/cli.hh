@@ -0,0 +1,41 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// Numbers on the command line & in job files - the whole text has to be the
+// number, so a typo is an error rather than a silent 0.
+
+// decimal, above 0 - counts, budgets & rates
+bool parse_count(std::string_view, uint64_t&);
+
+// decimal, or hex with a 0x prefix, 0 allowed - seeds
+bool parse_number(std::string_view, uint64_t&);
@@ -0,0 +1,160 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+#include "chip8.hh"
+#include "engine.hh"
+#include "frontend.hh"
+
+class Dispatcher;
+
+// A decoded instruction - handler plus operands already pulled out of the opcode
+struct Op {
+    void (*fn)(Dispatcher&, const Op&);
+    uint8_t x;
+    uint8_t y;
+    uint8_t n;
+    uint16_t nnn;   // NNN, or NN for the xNN forms
+    uint8_t stat;   // stat_slot() of the opcode, fits in the padding
+};
+
+// A straight-line run of decoded instructions, from its start address up to &
+// including the next instruction that can change the program counter (jump,
+// skip, call, return, FX0A) or write memory (FX33, FX55)
+struct Block {
+    uint16_t start;
+    uint16_t end;       // address just past the last instruction
+    uint32_t first_op;  // index of the first Op in Dispatcher::ops
+    uint32_t len;
+};
+
+// Block-translating engine. The first visit to an address decodes the run of
+// code starting there into a Block of Ops (handler + operands already pulled
+// out of the opcode); later visits reuse it, so tight loops are only decoded
+// once. Only the last Op of a block ever looks at the program counter, the
+// rest are executed back to back. Writes to memory (FX33, FX55) throw away
+// every block covering the written bytes so self-modifying code still works.
+// Quirky instructions decode straight to a handler specialised on the
+// machine's quirks; if those change, everything is decoded again.
+class Dispatcher : public Engine, public MemoryWatcher {
+    Chip8& chip8;
+    Frontend& io;
+
+    // block storage - killed blocks are left in place until the next flush
+    std::vector<Op> ops;
+    std::vector<Block> blocks;
+
+    // index into blocks for each start address, -1 if not translated
+    std::array<int32_t, 4096> block_at;
+
+    // bytes covered by at least one live block
+    std::bitset<4096> code_bytes;
+
+    // quirk bits the blocks were decoded for, and the decoder for them
+    uint8_t quirks;
+    Op (*decoder)(uint16_t);
+
+public:
+    Dispatcher(Chip8&, Frontend&);
+    ~Dispatcher();
+
+    uint64_t run(uint64_t) override;
+
+    // run the block at the program counter, or as much of it as fits in n
+    // instructions - the program counter must not be past the end of memory
+    uint64_t run_block(uint64_t);
+
+    void on_write(uint16_t, uint16_t) override;
+
+    // throw away every translated block
+    void invalidate_all();
+
+    // pick up a change of quirks, true (& every block thrown away) if they had changed
+    bool sync_quirks();
+
+    template <typename Q> static Op decode(uint16_t);
+
+    // true for instructions that have to end a block
+    static bool ends_block(uint16_t);
+
+private:
+    const Block& translate(uint16_t);
+
+    // handlers - only the last Op of a block may rely on the program counter,
+    // which has already been stepped past it
+    static void op_nop(Dispatcher&, const Op&);
+    static void op_cls(Dispatcher&, const Op&);
+    static void op_ret(Dispatcher&, const Op&);
+    static void op_scroll_down(Dispatcher&, const Op&);
+    static void op_scroll_up(Dispatcher&, const Op&);
+    static void op_scroll_right(Dispatcher&, const Op&);
+    static void op_scroll_left(Dispatcher&, const Op&);
+    static void op_exit(Dispatcher&, const Op&);
+    static void op_lores(Dispatcher&, const Op&);
+    static void op_hires(Dispatcher&, const Op&);
+    static void op_jump(Dispatcher&, const Op&);
+    static void op_call(Dispatcher&, const Op&);
+    static void op_se_const(Dispatcher&, const Op&);
+    static void op_sne_const(Dispatcher&, const Op&);
+    static void op_se(Dispatcher&, const Op&);
+    static void op_sne(Dispatcher&, const Op&);
+    static void op_ld_const(Dispatcher&, const Op&);
+    static void op_add_const(Dispatcher&, const Op&);
+    static void op_ld(Dispatcher&, const Op&);
+    static void op_or(Dispatcher&, const Op&);
+    static void op_and(Dispatcher&, const Op&);
+    static void op_xor(Dispatcher&, const Op&);
+    static void op_add(Dispatcher&, const Op&);
+    static void op_sub(Dispatcher&, const Op&);
+    template <typename Q> static void op_shr(Dispatcher&, const Op&);
+    static void op_subn(Dispatcher&, const Op&);
+    template <typename Q> static void op_shl(Dispatcher&, const Op&);
+    static void op_ld_i(Dispatcher&, const Op&);
+    template <typename Q> static void op_jump_offset(Dispatcher&, const Op&);
+    static void op_rand(Dispatcher&, const Op&);
+    static void op_draw(Dispatcher&, const Op&);
+    static void op_skp(Dispatcher&, const Op&);
+    static void op_sknp(Dispatcher&, const Op&);
+    static void op_planes(Dispatcher&, const Op&);
+    static void op_get_delay(Dispatcher&, const Op&);
+    static void op_wait_key(Dispatcher&, const Op&);
+    static void op_set_delay(Dispatcher&, const Op&);
+    static void op_set_sound(Dispatcher&, const Op&);
+    static void op_add_i(Dispatcher&, const Op&);
+    static void op_font(Dispatcher&, const Op&);
+    static void op_big_font(Dispatcher&, const Op&);
+    static void op_bcd(Dispatcher&, const Op&);
+    template <typename Q> static void op_dump(Dispatcher&, const Op&);
+    template <typename Q> static void op_load(Dispatcher&, const Op&);
+};
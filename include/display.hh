@@ -0,0 +1,65 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// The display - up to 128x64 pixels (SUPER-CHIP hires) on two bitplanes
+// (XO-CHIP), each row a packed bitset of 64 bit words with the most
+// significant bit of word 0 the leftmost pixel. Sprites, clears & scrolls
+// work on whole words.
+//
+// 64x32 (lores) uses word 0 of rows 0-31 only, with everything else kept at
+// 0 - the same one word a row the classic display always had.
+struct Screen {
+    static constexpr int max_width = 128;
+    static constexpr int max_height = 64;
+    static constexpr int row_words = max_width / 64;
+    static constexpr int plane_count = 2;
+
+    using Row = std::array<uint64_t, row_words>;
+    using Plane = std::array<Row, max_height>;
+
+    std::array<Plane, plane_count> planes;
+    bool hires;
+
+    int width() const {
+        return hires ? max_width : max_width / 2;
+    }
+
+    int height() const {
+        return hires ? max_height : max_height / 2;
+    }
+
+    bool operator==(const Screen&) const = default;
+};
+
+// bit n set - row n
+constexpr uint64_t all_rows = ~uint64_t(0);
@@ -0,0 +1,133 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "chip8.hh"
+#include "engine.hh"
+#include "frontend.hh"
+#include "headless.hh"
+#include "input_queue.hh"
+#include "rewind.hh"
+#include "triple_buffer.hh"
+
+class Beeper;
+class MovieReader;
+class MovieWriter;
+
+// Runs a Chip8 through the Scheduler on its own thread, so a stalled present
+// on the UI thread never holds up instruction pacing.
+// Keys come from an InputQueue when there is one, applied at the instruction
+// matching when each event happened. Otherwise (& while recording or playing
+// a movie) they are latched once at the start of every frame & held for the
+// frame - from the input frontend, which must be safe to query from another
+// thread - so a run is fully determined by its per-frame keypad masks, which
+// can be recorded to a movie or taken from one.
+// Display snapshots are published through a triple buffer that the UI thread
+// picks up with take_frame().
+// With a rewind budget every frame is recorded, and while rewinding is set
+// the thread steps back one recorded frame per frame instead of running.
+// The sound timer goes out to the Beeper as an on / off edge per change.
+// At any speed other than real time the beeper is muted, and frames are
+// published at most 60 times a second of host time - the ones in between are
+// skipped.
+class EmuThread : public Frontend {
+    Chip8& chip8;
+    Frontend& input;
+    HeadlessFrontend keypad;    // keys as of the start of the frame
+    MovieWriter* record;
+    MovieReader* play;
+    Beeper* beeper;
+    InputQueue* queue;
+    std::vector<KeyStep> steps;
+    uint64_t unshown_input_ns;      // oldest key press not on a published frame yet
+    uint64_t unshown_frame;         // frame it was applied on
+    std::unique_ptr<Engine> engine;
+    std::unique_ptr<Rewind> rewind;
+
+    TripleBuffer<Screen> frames;
+    std::atomic<uint64_t> shown_input_ns;   // press behind the newest published frame
+
+    std::atomic<int> speed;                 // see Scheduler::set_speed()
+    std::atomic<uint64_t> frame_count;
+    bool throttle_presents;                 // not running at real time
+    bool present_pending;                   // a skipped frame changed the display
+    std::chrono::steady_clock::time_point next_present;
+
+    std::atomic<bool> stop_requested;
+    std::atomic<bool> stopped;
+    std::atomic<bool> hit_end_of_mem;
+    std::atomic<bool> rewinding;
+
+    std::thread thread;
+
+    void loop();
+    void latch_keys(uint64_t, uint64_t);
+    void publish(const Screen&);
+
+public:
+    // engine_name - see make_engine()
+    // rewind_budget - bytes of rewind history, 0 for none
+    // record - movie to append every frame's keys to, or nullptr
+    // play - movie to take keys from until it runs out, or nullptr
+    // movies only stay in sync with no rewind history
+    // beeper - where the sound timer goes, or nullptr for silence
+    // queue - timestamped key events, or nullptr to latch the input frontend
+    EmuThread(Chip8&, Frontend&, std::string_view, size_t = 0, MovieWriter* = nullptr, MovieReader* = nullptr,
+              Beeper* = nullptr, InputQueue* = nullptr);
+    ~EmuThread();
+
+    // UI thread
+    void stop();
+    bool is_running();
+    bool end_of_mem();
+    void set_rewinding(bool);
+
+    // multiple of real time to run at, 0 for as fast as the host allows
+    void set_speed(int);
+
+    // frames emulated so far, for measuring the speed actually reached
+    uint64_t get_frame_count();
+
+    // copy out the newest published display, false if there is nothing new
+    // input_ns - when the key press it's the first to show happened, 0 if none
+    bool take_frame(Screen&, uint64_t&);
+
+    // emulation thread
+    bool key_is_pressed(uint8_t) override;
+    int  get_curr_key() override;
+    void draw_pixels(const Screen&, uint64_t) override;
+};
@@ -0,0 +1,54 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "chip8.hh"
+#include "frontend.hh"
+
+// An execution strategy for a Chip8 + Frontend pair
+class Engine {
+public:
+    virtual ~Engine() = default;
+
+    // run up to n instructions, returns the number actually executed
+    // (stops early if the program counter runs past the end of memory)
+    virtual uint64_t run(uint64_t) = 0;
+};
+
+// name - "switch" (reference decoder), "dispatch" (pre-decoded blocks) or
+//        "jit" (x86-64 builds only)
+// returns nullptr for an unknown name
+std::unique_ptr<Engine> make_engine(std::string_view, Chip8&, Frontend&);
+
+// whether make_engine() knows the name, for checking options up front
+bool has_engine(std::string_view);
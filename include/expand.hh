@@ -0,0 +1,67 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Colours for the 1bpp -> RGBA expansion, packed 0xRRGGBBAA
+// (SDL_PIXELFORMAT_RGBA8888) - plane2 & both only show up with XO-CHIP's
+// second plane in use
+struct Palette {
+    uint32_t fg = 0xFFFFFFFF;
+    uint32_t bg = 0x000000FF;
+    uint32_t plane2 = 0xFF6600FF;
+    uint32_t both = 0x662200FF;
+};
+
+enum class ExpandKernel { Scalar, SSE2, AVX2 };
+
+// Expand rows of packed 1bpp pixels (most significant bit = leftmost pixel)
+// into RGBA, using the fastest kernel the CPU supports.
+// words - rows * (width / 64) words, rows back to back
+// width - pixels per row, a multiple of 64
+// out - rows * width pixels
+void expand_rows(const uint64_t*, size_t, size_t, uint32_t*, Palette);
+
+// same, forcing a particular kernel (it must be supported)
+void expand_rows_with(ExpandKernel, const uint64_t*, size_t, size_t, uint32_t*, Palette);
+
+// Expand two planes into one image - bg, fg (plane 1), plane2, or both per
+// pixel. Rows with nothing on plane 2 go through expand_rows().
+// plane0, plane1 - rows * (width / 64) words each
+void expand_planes(const uint64_t*, const uint64_t*, size_t, size_t, uint32_t*, Palette);
+
+bool expand_kernel_supported(ExpandKernel);
+ExpandKernel expand_kernel_best();
+char const* expand_kernel_name(ExpandKernel);
+
+// "RRGGBB" or "#RRGGBB" -> 0xRRGGBBFF, false if it doesn't parse
+bool parse_color(std::string_view, uint32_t&);
@@ -0,0 +1,53 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <cstdint>
+
+#include "display.hh"
+
+// Everything the Chip8 core needs from whatever is hosting it: keypad state
+// in, display frames out (presented by the Scheduler once per frame).
+// WindowHandler implements this on top of SDL; the headless runner implements
+// it with no window at all.
+class Frontend {
+public:
+    virtual ~Frontend() = default;
+
+    // key - chip 8 key value (0x0 - 0xF)
+    virtual bool key_is_pressed(uint8_t) = 0;
+
+    // most recent key still held down, -1 if none
+    virtual int  get_curr_key() = 0;
+
+    // called at most once per frame, only when something changed
+    // display - the Chip8 display, both planes at whatever resolution it is in
+    // dirty_rows - bit n set if row n changed since the last call
+    virtual void draw_pixels(const Screen&, uint64_t) = 0;
+};
@@ -0,0 +1,52 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <cstdint>
+
+#include "frontend.hh"
+
+// Frontend with no window, no SDL & no dialogs. Keys are whatever the caller
+// sets them to (nothing pressed by default), frames are counted & dropped.
+class HeadlessFrontend : public Frontend {
+    uint16_t keys;
+    int last_key_down;
+    uint64_t draw_count;
+
+public:
+    HeadlessFrontend();
+
+    // keys - bitmask, bit n set means chip 8 key n is held down
+    void set_keys(uint16_t);
+    uint64_t get_draw_count();
+
+    bool key_is_pressed(uint8_t) override;
+    int  get_curr_key() override;
+    void draw_pixels(const Screen&, uint64_t) override;
+};
@@ -0,0 +1,110 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "spsc_ring.hh"
+
+// A key going down or up, stamped with the host time it happened
+// time_ns - steady_clock nanoseconds
+struct InputEvent {
+    uint64_t time_ns;
+    uint8_t key;
+    bool down;
+};
+
+// Keypad for the rest of the frame from instruction offset on
+struct KeyStep {
+    uint64_t offset;
+    uint16_t keys;
+    uint64_t time_ns;   // when the event behind it happened
+};
+
+// Key events from the UI thread to the emulation thread, applied at the
+// instruction matching when they happened rather than whenever the keypad
+// happens to be looked at.
+//
+// A frame's instructions run in one burst at the start of the frame, so the
+// burst plays back the events of the frame before it: an event a quarter of
+// the way through that frame lands a quarter of the way through the burst's
+// budget. Input is a fixed frame late, but keeps its timing within the frame.
+// Steps are kept at least two instructions apart (so FX0A sees a tap that
+// went down & up between two polls); anything pushed past the end of the
+// budget waits for the next frame, nothing is dropped.
+class InputQueue {
+    SpscRing<InputEvent, 256> ring;
+
+    // consumer only
+    std::vector<InputEvent> pending;
+    uint16_t keys;
+    uint64_t window_start;      // host time the last taken frame covered up to
+
+    void drain();
+
+public:
+    InputQueue();
+
+    // UI thread - false if the queue is full & the event was lost
+    bool push(const InputEvent&);
+
+    // emulation thread - steps for a frame of budget instructions covering
+    // the events up to now_ns
+    // per_frame - apply every change at offset 0 (needed to record / replay
+    // per-frame movies), a key changing twice waits for the next frame
+    void take_frame(uint64_t, uint64_t, bool, std::vector<KeyStep>&);
+
+    // emulation thread - apply everything up to now_ns at once, e.g. while
+    // the program isn't running
+    void skip(uint64_t);
+
+    // keypad after every step taken so far
+    uint16_t get_keys();
+};
+
+// Host time from input to the display showing the frame it went into
+class LatencyStats {
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t min_ns;
+    uint64_t max_ns;
+
+public:
+    LatencyStats();
+
+    void add(uint64_t);
+    uint64_t get_count();
+    uint64_t get_min_ns();
+    uint64_t get_max_ns();
+    uint64_t get_mean_ns();
+};
+
+// steady_clock now, in the units InputEvent uses
+uint64_t input_clock_ns();
@@ -0,0 +1,56 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include "chip8.hh"
+#include "engine.hh"
+#include "frontend.hh"
+
+// instruction decode macros
+#define OP(ins) ((ins & 0xF000) >> 12)
+#define X(ins) ((ins & 0x0F00) >> 8)
+#define Y(ins) ((ins & 0x00F0) >> 4)
+#define N(ins) (ins & 0x000F)
+#define NN(ins) (ins & 0x00FF)
+#define NNN(ins) (ins & 0x0FFF)
+
+// Fetch, decode & execute a single instruction
+// returns 0 - ok,  1 - program counter ran past the end of memory
+int instruction_cycle(Chip8&, Frontend&);
+
+
+// Reference engine - runs instruction_cycle() one instruction at a time
+class SwitchEngine : public Engine {
+    Chip8& chip8;
+    Frontend& io;
+
+public:
+    SwitchEngine(Chip8&, Frontend&);
+    uint64_t run(uint64_t) override;
+};
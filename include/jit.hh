@@ -0,0 +1,90 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "chip8.hh"
+#include "dispatch.hh"
+#include "engine.hh"
+#include "frontend.hh"
+
+// compiled block - takes V0-VF, memory & I, returns the next program counter
+using JitCode = uint32_t (*)(uint8_t*, uint8_t*, uint16_t*);
+
+struct JitBlock {
+    JitCode code;       // nullptr if not compiled
+    uint16_t end;       // address just past the last compiled instruction
+    uint16_t len;
+    uint16_t heat;      // visits while not compiled
+    bool uncompilable;  // first instruction has to go through the interpreter
+};
+
+// x86-64 JIT. Code that keeps being visited is compiled into native code in
+// mmap'd pages, with V registers & I held in host registers for the whole
+// block. Anything that touches the display, keypad, timers, stack, rand or
+// writes memory (00E0, 00EE, 2NNN, CXNN, DXYN, EXxx, FX07, FX0A, FX15, FX18,
+// FX33, FX55) ends a block & runs through the Dispatcher instead, as does any
+// block overwritten by the program.
+class Jit : public Engine, public MemoryWatcher {
+    Chip8& chip8;
+    Dispatcher fallback;
+
+    std::array<JitBlock, 4096> jit_at;
+
+    // bytes covered by at least one compiled block
+    std::bitset<4096> code_bytes;
+
+#ifdef CHIP8_STATS
+    // stat_slot() of each compiled instruction, by address
+    std::array<uint8_t, 4096> stat_at;
+#endif
+
+    // executable code region, bump allocated & flushed when full
+    uint8_t* region;
+    size_t region_size;
+    size_t region_used;
+
+public:
+    Jit(Chip8&, Frontend&);
+    ~Jit();
+
+    uint64_t run(uint64_t) override;
+    void on_write(uint16_t, uint16_t) override;
+
+    // throw away every compiled block
+    void invalidate_all();
+
+private:
+    bool compile(uint16_t);
+};
@@ -0,0 +1,160 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "savestate.hh"
+
+// Many machines running the same ROM, kept in structure-of-arrays form: V0 of
+// every lane sits in one contiguous array, V1 in the next, and likewise for
+// I, the program counter, timers, stack & keypad. Memory & display are
+// addressed through registers that differ per lane, so those stay whole per
+// lane.
+//
+// Each step picks the lowest program counter among lanes with budget left &
+// runs that instruction for every lane sitting on it, under a lane mask. The
+// group keeps stepping together until an instruction that can send lanes
+// different ways (skip, call, return, BNNN, key ops, FX0A), then regroups -
+// lanes that branched apart fall back into step when their paths meet again.
+// Register ops, skips, timers & index ops run across the masked lanes in
+// vectorised loops (AVX2 when the CPU has it); draws, memory & the stack go
+// lane by lane.
+//
+// Configuration (ips & quirks) is shared by all lanes.
+// Lanes have a 64x32 single plane display. The SUPER-CHIP / XO-CHIP
+// instructions that make sense there run as Chip8 runs them in lores (00CN,
+// 00DN, 00FB-00FE, DXY0, FX30, FN01 selecting plane 1). 00FF & FN01 selecting
+// anything else stop the lane on the instruction & mark it unsupported - from
+// then on it no longer matches its own Chip8. load_lane() turns away states
+// in hires or with another plane selected.
+class Lockstep {
+    size_t lanes;
+    size_t stride;      // lanes rounded up to a whole vector, padding never runs
+
+    // one array per register, indexed by lane
+    std::array<std::vector<uint8_t>, 16> var_regs;
+    std::vector<uint16_t> index_register;
+    std::vector<uint16_t> program_counter;
+    std::vector<uint8_t> delay_timer;
+    std::vector<uint8_t> sound_timer;
+    std::array<std::vector<uint16_t>, 16> stack;
+    std::vector<uint8_t> stack_pointer;
+    std::vector<int8_t> block_state;
+    std::vector<uint64_t> rng_state;
+
+    // keypad - bitmask & last key down, as HeadlessFrontend keeps them
+    std::vector<uint16_t> keys;
+    std::vector<int8_t> last_key_down;
+
+    // whole per lane - 4096 bytes / 32 rows starting at lane * size
+    std::vector<uint8_t> memory;
+    std::vector<uint64_t> display;
+
+    // memory every lane started out with, & the addresses where some lane's
+    // memory may no longer match it - code fetched from there is checked lane
+    // by lane
+    std::array<uint8_t, 4096> image;
+    std::bitset<4096> written;
+
+    // shared configuration
+    int inst_per_sec;
+    bool shift_use_vy;
+    bool jump_offset_vx;
+    bool store_load_i_inc;
+    uint64_t frame_count;
+
+    // scratch for a run - instructions each lane may still execute, and the
+    // lanes in the current group
+    std::vector<uint32_t> left;
+    std::vector<uint8_t> mask;
+
+    // lanes halted on an instruction they can't run
+    std::vector<uint8_t> unsupported;
+
+    // occupancy - group steps taken & lane steps they covered
+    uint64_t group_steps;
+    uint64_t lane_steps;
+
+    uint8_t* lane_memory(size_t lane) { return &memory[lane * 4096]; }
+    uint64_t* lane_display(size_t lane) { return &display[lane * 32]; }
+
+    void run_chunk();
+    void run_group(uint16_t, size_t, uint32_t, size_t);
+    bool execute(uint16_t);
+
+    // lane by lane ops
+    void draw(size_t, uint8_t, uint8_t, uint8_t);
+    void scroll_vertical(size_t, uint8_t, bool);
+    void scroll_sideways(size_t, bool);
+    void halt(size_t);
+    void wait_key(size_t, uint8_t);
+    void bcd(size_t, uint8_t);
+    void reg_dump(size_t, uint8_t);
+    void reg_load(size_t, uint8_t);
+
+public:
+    // every lane starts out as the machine in the state, which also supplies
+    // the shared configuration
+    Lockstep(const SaveState&, size_t);
+
+    size_t get_lanes();
+
+    // one lane to / from a whole machine - configuration in the state is
+    // ignored on load, 1 - wrong magic / version, nothing changed
+    void save_lane(size_t, SaveState&);
+    int  load_lane(size_t, const SaveState&);
+
+    // keys - bitmask, bit n set means chip 8 key n is held down
+    void set_keys(size_t, uint16_t);
+    void seed_rand(size_t, uint64_t);
+
+    // every lane executes n instructions (fewer if it runs off the end of
+    // memory), returns instructions executed over all lanes
+    uint64_t run(uint64_t);
+
+    // one 60 Hz frame for every lane, the same budget a Scheduler would give
+    uint64_t run_frame();
+    void tick_timers();
+
+    // access
+    bool end_of_mem(size_t);
+    uint8_t get_var_reg(size_t, uint8_t);
+    uint16_t get_index(size_t);
+    uint16_t get_pc(size_t);
+    bool is_unsupported(size_t);     // halted on 00FF or FN01, pc on it
+    std::span<const uint64_t, 32> get_display(size_t);
+
+    // average lanes per group step since construction
+    double get_occupancy();
+};
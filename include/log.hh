@@ -0,0 +1,102 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+#include "spsc_ring.hh"
+
+// Logging that never blocks the thread doing it. A message is a format
+// string literal plus up to four integer arguments, stored as is in the
+// calling thread's own lock-free ring - a clock read & a handful of stores.
+// A background thread drains every ring, formats & writes to stderr. If a
+// ring is full the message is dropped & counted instead of waiting.
+//
+// Messages below CHIP8_LOG_LEVEL (0 trace, 1 debug, 2 info, 3 warn, 4 error,
+// 5 none - set with -DCHIP8_LOG_LEVEL=N) compile to nothing.
+//
+//     CHIP8_LOG(Debug, "key {} down, held {}", key, held);
+
+#ifndef CHIP8_LOG_LEVEL
+#define CHIP8_LOG_LEVEL 2
+#endif
+
+enum class LogLevel : uint8_t {
+    Trace,
+    Debug,
+    Info,
+    Warn,
+    Error
+};
+
+struct LogRecord {
+    static constexpr int max_args = 4;
+
+    uint64_t time_ns;       // steady clock
+    char const* format;     // "{}" is replaced by the next argument
+    int64_t args[max_args];
+    LogLevel level;
+    uint8_t arg_count;
+};
+
+struct ThreadLog {
+    SpscRing<LogRecord, 1024> ring;
+    std::atomic<uint64_t> dropped{0};
+};
+
+// this thread's ring, registered with the drain thread on first use
+ThreadLog& log_register();
+extern thread_local ThreadLog* log_local;
+
+template <typename... Args>
+inline void log_write(LogLevel level, char const* format, Args... args) {
+    static_assert(sizeof...(Args) <= LogRecord::max_args, "at most 4 log arguments");
+    static_assert((std::is_integral_v<Args> && ...), "log arguments must be integers");
+
+    ThreadLog* log = log_local;
+    if (!log)
+        log = &log_register();
+
+    LogRecord record{
+        uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count()),
+        format, {int64_t(args)...}, level, uint8_t(sizeof...(Args))
+    };
+    if (!log->ring.push(record))
+        log->dropped.fetch_add(1, std::memory_order_relaxed);     // the drain thread resets it
+}
+
+#define CHIP8_LOG(level, ...)                                       \
+    do {                                                            \
+        if constexpr (int(LogLevel::level) >= CHIP8_LOG_LEVEL)      \
+            log_write(LogLevel::level, __VA_ARGS__);                \
+    } while (0)
@@ -0,0 +1,121 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <type_traits>
+
+#include "chip8.hh"
+
+// Input movie - everything needed to replay a run from power-on bit for bit:
+// the configuration & CXNN seed up front, then the keypad bitmask of every
+// frame. Keys are only sampled once a frame (see EmuThread), so the masks
+// alone reproduce the run.
+//
+// File layout: MovieHeader as raw bytes (host byte order, like SaveState),
+// then runs of identical frames until end of file, each a LEB128 varint frame
+// count followed by the 16 bit keypad mask, low byte first.
+struct MovieHeader {
+    static constexpr uint32_t magic_value   = 0x564D3843;   // "C8MV"
+    static constexpr uint32_t current_version = 1;
+
+    uint32_t magic;
+    uint32_t version;
+
+    uint64_t seed;
+    uint64_t rom_hash;      // FNV-1a of memory from 0x200 at power-on
+
+    int32_t inst_per_sec;
+    uint8_t shift_use_vy;
+    uint8_t jump_offset_vx;
+    uint8_t store_load_i_inc;
+    uint8_t reserved;
+};
+
+static_assert(std::is_trivially_copyable_v<MovieHeader>);
+static_assert(sizeof(MovieHeader) == 8 + 8 + 8 + 4 + 4, "MovieHeader layout must not have padding");
+
+// header for a machine at power-on that's about to be seeded with seed
+MovieHeader make_movie_header(Chip8&, uint64_t);
+
+// configure & seed a machine at power-on to replay the movie
+// returns 0 - ok,  1 - the machine's ROM isn't the one the movie was recorded on
+int start_movie(Chip8&, const MovieHeader&);
+
+// Streams frames out as they happen, only a run of identical frames is held back
+class MovieWriter {
+    std::FILE* out;
+    uint16_t run_keys;
+    uint64_t run_length;
+    uint64_t frames;
+    bool failed;
+
+    void write_run();
+
+public:
+    MovieWriter();
+    ~MovieWriter();
+
+    MovieWriter(const MovieWriter&) = delete;
+    MovieWriter& operator=(const MovieWriter&) = delete;
+
+    // returns 0 - ok,  1 - couldn't create the file
+    int open(const std::filesystem::path&, const MovieHeader&);
+
+    // keypad of the next frame
+    void record(uint16_t);
+
+    // writes the last run, returns 0 - ok,  1 - any write failed
+    int close();
+
+    uint64_t get_frames();
+};
+
+class MovieReader {
+    std::FILE* in;
+    MovieHeader header;
+    uint16_t run_keys;
+    uint64_t run_left;
+
+public:
+    MovieReader();
+    ~MovieReader();
+
+    MovieReader(const MovieReader&) = delete;
+    MovieReader& operator=(const MovieReader&) = delete;
+
+    // returns 0 - ok,  1 - I/O error, short header, or wrong magic / version
+    int open(const std::filesystem::path&);
+    const MovieHeader& get_header();
+
+    // keypad of the next frame, false once the movie is over
+    bool next(uint16_t&);
+};
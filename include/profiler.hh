@@ -0,0 +1,91 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "chip8.hh"
+#include "engine.hh"
+#include "frontend.hh"
+
+// Exact guest profiler. Runs the program one instruction at a time (like the
+// switch engine) & charges every instruction to its address & to the stack
+// of subroutines it ran under. The stack is rebuilt from the call & return
+// edges Chip8 reports, starting from a root routine, "main", wherever the
+// profiler took over.
+//
+// Reports: a flat profile (self & total instructions per routine, the call
+// graph edges & the hottest addresses) and folded stacks - one
+// "main;sub_2A0;sub_31C 1234" line per stack, which flamegraph.pl,
+// inferno & speedscope read as is.
+class Profiler : public Engine, public CallWatcher {
+    static constexpr uint16_t root = 0xFFFF;    // routine id of main, no NNN is this high
+
+    // one node per distinct call stack seen
+    struct Node {
+        uint16_t routine;
+        int32_t parent;     // -1 - root
+        uint64_t count;     // instructions run with exactly this stack
+    };
+
+    Chip8& chip8;
+    Frontend& io;
+
+    std::vector<Node> nodes;
+    std::unordered_map<uint64_t, int32_t> children;     // parent << 16 | routine -> node
+    int32_t current;
+
+    std::array<uint64_t, 4096> hits;            // instructions run per address
+    std::array<uint16_t, 4096> owner;           // routine an address last ran under
+    std::map<std::pair<uint16_t, uint16_t>, uint64_t> edges;    // caller, callee -> calls
+    uint64_t total;
+
+    std::vector<uint16_t> stack_of(int32_t);
+
+public:
+    Profiler(Chip8&, Frontend&);
+    ~Profiler();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    uint64_t run(uint64_t) override;
+    void on_call(uint16_t, uint16_t) override;
+    void on_return(uint16_t) override;
+
+    // returns 0 - ok,  1 - couldn't write the file
+    int write_flat(const std::filesystem::path&);
+    int write_folded(const std::filesystem::path&);
+};
@@ -0,0 +1,84 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// Compile-time quirk policy - which reading of the ambiguous original
+// instructions a ROM expects. Engines are templated on one of these & pick
+// the instantiation once, from the machine's flags, instead of testing the
+// flags every time a quirky instruction runs.
+template <bool ShiftVY, bool JumpVX, bool LoadInc>
+struct Quirks {
+    // 8XY6 / 8XYE : shift VY into VX (otherwise shift VX in place)
+    static constexpr bool shift_use_vy = ShiftVY;
+    // BNNN : jump to XNN + VX (otherwise NNN + V0)
+    static constexpr bool jump_offset_vx = JumpVX;
+    // FX55 / FX65 : leave I just past the last register (otherwise unchanged)
+    static constexpr bool store_load_i_inc = LoadInc;
+
+    static constexpr uint8_t bits = (ShiftVY ? 1 : 0) | (JumpVX ? 2 : 0) | (LoadInc ? 4 : 0);
+};
+
+// the well known interpreters, as far as these three quirks go
+using QuirksVIP       = Quirks<true,  false, true>;    // COSMAC VIP
+using QuirksChip48    = Quirks<false, true,  false>;   // HP48 CHIP-48
+using QuirksSuperChip = Quirks<false, true,  false>;   // SUPER-CHIP 1.1
+
+// power-on default - none of the quirks
+using QuirksDefault   = Quirks<false, false, false>;
+
+enum class QuirkProfile {
+    VIP,
+    Chip48,
+    SuperChip,
+};
+
+// "vip", "chip48" or "schip", false for anything else
+bool parse_quirk_profile(std::string_view, QuirkProfile&);
+
+// quirk bits (Quirks::bits layout) of a profile
+uint8_t quirk_profile_bits(QuirkProfile);
+
+// The one runtime branch - calls f.template operator()<Quirks<...>>() for
+// the quirk bits given & returns whatever that returns
+template <typename F>
+decltype(auto) with_quirks(uint8_t bits, F&& f) {
+    switch (bits & 7) {
+    case 0:     return f.template operator()<Quirks<false, false, false>>();
+    case 1:     return f.template operator()<Quirks<true,  false, false>>();
+    case 2:     return f.template operator()<Quirks<false, true,  false>>();
+    case 3:     return f.template operator()<Quirks<true,  true,  false>>();
+    case 4:     return f.template operator()<Quirks<false, false, true>>();
+    case 5:     return f.template operator()<Quirks<true,  false, true>>();
+    case 6:     return f.template operator()<Quirks<false, true,  true>>();
+    default:    return f.template operator()<Quirks<true,  true,  true>>();
+    }
+}
@@ -0,0 +1,76 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "savestate.hh"
+
+// Rewind history - one SaveState per frame, under a fixed memory budget.
+// Only the newest state is kept whole; every older frame is stored as the
+// XOR of it & the frame after it, which is almost all zero bytes (a frame
+// touches a few registers, a few display rows, maybe a few bytes of memory),
+// with the zero runs squeezed out. Records go into one preallocated byte ring
+// and the oldest are dropped when a new one doesn't fit, so the budget
+// decides how many seconds are kept.
+class Rewind {
+    std::vector<uint8_t> ring;
+    size_t head;        // where the next record goes
+    size_t tail;        // start of the oldest record
+    size_t used;
+    size_t count;       // records in the ring
+
+    SaveState newest;
+    bool have_newest;
+
+    std::vector<uint8_t> scratch;   // compressed record being built
+
+    void ring_write(const uint8_t*, size_t);
+    void ring_read(size_t, uint8_t*, size_t);
+    uint32_t ring_read_u32(size_t);
+    void drop_oldest();
+
+public:
+    // budget - bytes of history to keep
+    Rewind(size_t);
+
+    // record the state at the end of a frame
+    void push(const SaveState&);
+
+    // step back one frame - out is the state at the end of the frame before
+    // the last one pushed (which is forgotten). false if there is no history
+    bool step_back(SaveState&);
+
+    void clear();
+
+    size_t frames();        // frames that can be stepped back
+    size_t bytes_used();
+};
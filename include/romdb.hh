@@ -0,0 +1,51 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+// Built-in table of known ROMs, keyed by a hash of the ROM file, with the
+// speed & quirks each one expects - so a ROM starts out configured right with
+// no flags given. The table is sorted by hash & looked up by binary search.
+struct RomInfo {
+    uint64_t hash;          // rom_hash() of the whole file
+    int32_t ips;            // 0 - no preference
+    int8_t quirks;          // Quirks::bits layout, -1 - no preference
+    char const* title;
+};
+
+// FNV-1a over the ROM image
+uint64_t rom_hash(std::span<const uint8_t>);
+
+// the entry for a hash, nullptr if the ROM isn't known
+const RomInfo* rom_lookup(uint64_t);
+
+// every entry, sorted by hash
+std::span<const RomInfo> rom_database();
@@ -0,0 +1,81 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <type_traits>
+
+// Fixed layout, versioned snapshot of a whole Chip8. It is plain data with no
+// padding, so saving & restoring is a straight copy and the blob on disk is
+// exactly these bytes (host byte order - a mismatch shows up as a bad magic).
+// The version goes up whenever the layout changes, and states of any other
+// version are rejected rather than converted.
+struct SaveState {
+    static constexpr uint32_t magic_value   = 0x53533843;   // "C8SS"
+    static constexpr uint32_t current_version = 3;
+
+    uint32_t magic;
+    uint32_t version;
+
+    std::array<uint8_t, 4096> memory;
+    std::array<uint64_t, 256> display;  // planes x 64 rows x 2 words
+    std::array<uint16_t, 16> stack;
+    std::array<uint8_t, 16> var_regs;
+
+    uint16_t index_register;
+    uint16_t program_counter;
+
+    uint8_t delay_timer;
+    uint8_t sound_timer;
+    uint8_t stack_pointer;
+    int8_t  block_state;
+
+    // configuration
+    int32_t inst_per_sec;
+    uint8_t shift_use_vy;
+    uint8_t jump_offset_vx;
+    uint8_t store_load_i_inc;
+    uint8_t hires;
+    uint8_t plane_mask;
+    uint8_t reserved[7];
+
+    uint64_t rng_state;
+};
+
+static_assert(std::is_trivially_copyable_v<SaveState>);
+static_assert(std::is_standard_layout_v<SaveState>);
+static_assert(sizeof(SaveState) == 8 + 4096 + 2048 + 32 + 16 + 4 + 4 + 4 + 3 + 2 + 7 + 8,
+              "SaveState layout must not have padding");
+
+// write / read a SaveState as a raw blob
+// returns 0 - ok,  1 - I/O error, short file, or wrong magic / version
+int write_state_file(const std::filesystem::path&, const SaveState&);
+int read_state_file(const std::filesystem::path&, SaveState&);
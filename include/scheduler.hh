@@ -0,0 +1,83 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+
+#include "chip8.hh"
+#include "engine.hh"
+#include "frontend.hh"
+#include "headless.hh"
+#include "input_queue.hh"
+
+// Paces a Chip8 in 60 Hz frames: each frame runs inst_per_sec / 60
+// instructions in one burst, ticks the delay & sound timers once, presents
+// the display if any row of it changed, then the host sleeps until the next
+// frame is due instead of spinning. Faster than real time, frames stay the
+// same - only the sleeps between them shrink, or go away when uncapped.
+class Scheduler {
+    Chip8& chip8;
+    Engine& engine;
+    Frontend& io;
+
+    static constexpr int frame_rate = 60;
+    std::chrono::nanoseconds frame_time;
+    std::chrono::steady_clock::time_point next_frame;
+    int speed;      // multiple of real time, 0 - uncapped
+
+    uint64_t frame_count;
+
+    uint64_t run_steps(std::span<const KeyStep>, HeadlessFrontend*);
+
+public:
+    Scheduler(Chip8&, Engine&, Frontend&);
+
+    // run one frame's worth of instructions, tick the timers & present
+    // returns the number of instructions executed
+    uint64_t run_frame();
+
+    // same, setting keypad to each step's keys as the burst reaches its
+    // offset (see InputQueue)
+    uint64_t run_frame(std::span<const KeyStep>, HeadlessFrontend&);
+
+    // instructions the next frame will run
+    uint64_t get_budget();
+
+    // sleep until the next frame is due - if the host has fallen more than a
+    // few frames behind, pacing restarts from now rather than bursting to catch up
+    void wait_frame();
+
+    // speed - multiple of real time wait_frame() paces to, 0 for no waiting
+    void set_speed(int);
+    int get_speed();
+
+    uint64_t get_frame_count();
+};
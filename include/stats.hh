@@ -0,0 +1,144 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <cstdint>
+
+// Execution statistics - instructions per opcode, draws & collisions, the
+// deepest the stack got, and a histogram of host time per emulated frame.
+//
+// Only built with -DCHIP8_STATS=ON; otherwise every hook below compiles to
+// nothing. Counters are per thread & only ever written by their own thread
+// (relaxed loads & stores, no locked instructions); the dump sums them.
+
+// opcode family in the high nibble, sub-op in the low one, e.g. 8XY4 -> 0x84,
+// FX55 -> 0xF7 (names are in stats.cc)
+constexpr uint8_t stat_slot(uint16_t inst) {
+    uint8_t family = inst >> 12;
+    uint8_t sub = 0;
+    switch (family) {
+    case 0x0:
+        switch (inst & 0xFFF) {
+        case 0x0E0: sub = 0;    break;
+        case 0x0EE: sub = 1;    break;
+        case 0x0FB: sub = 5;    break;
+        case 0x0FC: sub = 6;    break;
+        case 0x0FD: sub = 7;    break;
+        case 0x0FE: sub = 8;    break;
+        case 0x0FF: sub = 9;    break;
+        default:
+            sub = ((inst & 0xFF0) == 0x0C0) ? 3 : ((inst & 0xFF0) == 0x0D0) ? 4 : 2;
+            break;
+        }
+        break;
+    case 0x8:
+        sub = inst & 0xF;
+        break;
+    case 0xE:
+        sub = ((inst & 0xFF) == 0x9E) ? 0 : ((inst & 0xFF) == 0xA1) ? 1 : 2;
+        break;
+    case 0xF:
+        switch (inst & 0xFF) {
+        case 0x07:  sub = 0;    break;
+        case 0x0A:  sub = 1;    break;
+        case 0x15:  sub = 2;    break;
+        case 0x18:  sub = 3;    break;
+        case 0x1E:  sub = 4;    break;
+        case 0x29:  sub = 5;    break;
+        case 0x33:  sub = 6;    break;
+        case 0x55:  sub = 7;    break;
+        case 0x65:  sub = 8;    break;
+        case 0x01:  sub = 10;   break;
+        case 0x30:  sub = 11;   break;
+        default:    sub = 9;    break;
+        }
+        break;
+    }
+    return (family << 4) | sub;
+}
+
+#ifdef CHIP8_STATS
+
+#include <atomic>
+
+struct StatCounters {
+    static constexpr int frame_buckets = 24;    // bucket n - under 2^n microseconds
+
+    std::atomic<uint64_t> ops[256];
+    std::atomic<uint64_t> draws;
+    std::atomic<uint64_t> collisions;
+    std::atomic<uint64_t> max_stack_depth;
+    std::atomic<uint64_t> frames;
+    std::atomic<uint64_t> frame_us[frame_buckets];
+};
+
+// this thread's counters, registered for the dump on first use
+StatCounters& stat_register();
+extern thread_local StatCounters* stat_local;
+
+inline StatCounters& stat_counters() {
+    StatCounters* counters = stat_local;
+    return counters ? *counters : stat_register();
+}
+
+// single writer - a plain add, the atomic is only so the dump can read it
+inline void stat_add(std::atomic<uint64_t>& counter, uint64_t n) {
+    counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+inline void stat_max(std::atomic<uint64_t>& counter, uint64_t n) {
+    if (n > counter.load(std::memory_order_relaxed))
+        counter.store(n, std::memory_order_relaxed);
+}
+
+void stat_frame_time(uint64_t);     // nanoseconds
+
+// dump on exit & on SIGUSR1 to path (nullptr - stats aren't written anywhere)
+// call before starting any other thread, so SIGUSR1 is only taken by the dumper
+void stats_install(char const*);
+
+// sum of every thread's counters as JSON, returns 0 - ok,  1 - couldn't write
+int stats_dump(char const*);
+
+#define CHIP8_STAT_OP(slot)        stat_add(stat_counters().ops[(slot)], 1)
+#define CHIP8_STAT_DRAW(collided)  do { StatCounters& c_ = stat_counters(); \
+                                        stat_add(c_.draws, 1); stat_add(c_.collisions, (collided)); } while (0)
+#define CHIP8_STAT_STACK(depth)    stat_max(stat_counters().max_stack_depth, (depth))
+#define CHIP8_STAT_FRAME(ns)       stat_frame_time(ns)
+
+#else
+
+inline void stats_install(char const*) {}
+
+#define CHIP8_STAT_OP(slot)        ((void)0)
+#define CHIP8_STAT_DRAW(collided)  ((void)0)
+#define CHIP8_STAT_STACK(depth)    ((void)0)
+#define CHIP8_STAT_FRAME(ns)       ((void)0)
+
+#endif
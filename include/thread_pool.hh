@@ -0,0 +1,80 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed size pool of worker threads, each with its own task queue. Submitted
+// tasks are dealt round robin across the queues; a worker takes from the back
+// of its own queue and, once that runs dry, steals from the front of the
+// others. Long tasks landing on one worker don't hold up the rest of a batch.
+class WorkStealingPool {
+    struct Queue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    size_t next_queue;                  // submit() only
+
+    std::atomic<size_t> queued;         // tasks sitting in a queue
+    std::atomic<size_t> pending;        // tasks submitted but not yet finished
+    bool stopping;
+
+    std::mutex idle_lock;
+    std::condition_variable work_ready;
+    std::condition_variable all_done;
+
+    bool take(size_t, std::function<void()>&);
+    void worker_loop(size_t);
+
+public:
+    // threads - 0 picks one per hardware thread
+    explicit WorkStealingPool(unsigned threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // not thread safe - submit from one thread only
+    void submit(std::function<void()>);
+
+    // blocks until every task submitted so far has finished
+    void wait();
+
+    size_t size() const;
+};
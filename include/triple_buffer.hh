@@ -0,0 +1,72 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single producer / single consumer triple buffer. The producer
+// always has a slot to write into & never waits; the consumer always gets the
+// most recently published slot & never sees a half-written one. Frames the
+// consumer doesn't get to in time are simply replaced by newer ones.
+template <typename T>
+class TripleBuffer {
+    static constexpr uint8_t index_mask = 0x3;
+    static constexpr uint8_t fresh = 0x4;   // set in middle when it holds an unread slot
+
+    std::array<T, 3> slots{};
+    std::atomic<uint8_t> middle{1};
+    uint8_t back = 0;   // producer only
+    uint8_t front = 2;  // consumer only
+
+public:
+    // producer - slot to fill in before publish()
+    T& write_slot() {
+        return slots[back];
+    }
+
+    // producer - hand the filled slot over, get the stale one back to write into
+    void publish() {
+        back = middle.exchange(back | fresh, std::memory_order_acq_rel) & index_mask;
+    }
+
+    // consumer - swap in the newest published slot, false if nothing new
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & fresh))
+            return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & index_mask;
+        return true;
+    }
+
+    // consumer - slot from the last successful update()
+    const T& read_slot() const {
+        return slots[front];
+    }
+};
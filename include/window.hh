@@ -29,31 +29,59 @@ freely, subject to the following restrictions:
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <string>
 #include <filesystem>
 
 #include "SDL3/SDL_render.h"
 #include "SDL3/SDL_video.h"
 
-class WindowHandler {
+#include "expand.hh"
+#include "frontend.hh"
+#include "input_queue.hh"
+
+class WindowHandler : public Frontend {
     SDL_Window* window;
     SDL_Renderer* renderer;
     SDL_Texture* texture;
 
+    // expanded display, kept between frames so only changed rows are redone -
+    // always 128 wide, lores only uses the top left 64x32
+    std::array<uint32_t, Screen::max_width * Screen::max_height> pixels;
+    Palette palette;
+    bool repaint;   // palette or resolution changed, redo every row next frame
+    bool hires;     // resolution of what's in the texture
+
     bool is_running;
 
+    // written by poll_events() on the UI thread, read from the emulation thread
+    std::atomic<uint16_t> keys;     // bit n set - key n held
+    std::atomic<int> last_key_down;
+
+    // the same key events, timestamped, for the emulation thread
+    InputQueue input_queue;
+
+    bool rewind_held;   // backspace
+    bool turbo_held;    // tab
+    std::string title;
+
 public:
-    std::array<bool, 16> keys;
-    int last_key_down;
 
     WindowHandler();
     ~WindowHandler();
 
     void open_file();
-    void draw_pixels(std::array<uint64_t, 32>);
+    void draw_pixels(const Screen&, uint64_t) override;
+    void set_palette(Palette);
     void poll_events();
-    bool key_is_pressed(uint8_t);
-    int  get_curr_key();
+    // sleep until an event arrives or timeout_ms passes, then poll_events()
+    void wait_events(int);
+    bool key_is_pressed(uint8_t) override;
+    int  get_curr_key() override;
     void popup(std::string, std::string);
     bool get_run_status();
+    bool rewind_is_held();
+    bool turbo_is_held();
+    void set_title(const std::string&);
+    InputQueue& get_input_queue();
 };
\ No newline at end of file
@@ -0,0 +1,116 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <algorithm>
+
+#include "aot.hh"
+#include "stats.hh"
+
+AotEngine::AotEngine(Chip8& chip8, Frontend& io, const AotProgram& program)
+    : chip8(chip8), io(io), fallback(chip8, io), program(program) {
+    std::fill(block_at.begin(), block_at.end(), -1);
+    for (const AotBlock& block : program.blocks) {
+        for (int a=block.start; a<block.start + 2 * block.len && a<=0xFFF; a++)
+            code_bytes[a] = true;
+    }
+#ifdef CHIP8_STATS
+    for (const AotBlock& block : program.blocks) {
+        for (int i=0; i<block.len; i++) {
+            size_t at = block.start + 2 * i - 0x200;
+            if (block.start < 0x200 || at + 1 >= program.image.size())
+                break;
+            stat_at[block.start + 2 * i] = stat_slot((program.image[at] << 8) | program.image[at + 1]);
+        }
+    }
+#endif
+
+    verify(0, 0xFFF);
+    chip8.watch_memory(this);
+}
+
+AotEngine::~AotEngine() {
+    chip8.watch_memory(nullptr);
+}
+
+uint64_t AotEngine::run(uint64_t n) {
+    // the blocks have the program's quirks baked in
+    fallback.sync_quirks();
+    if (chip8.get_quirks() != program.quirks)
+        return fallback.run(n);
+
+    AotState state{chip8, io, chip8.var_regs.data(), chip8.index_register};
+
+    uint64_t executed = 0;
+    while (executed < n && !chip8.end_of_mem()) {
+        int32_t b = block_at[chip8.program_counter];
+
+        if (b >= 0 && program.blocks[b].len <= n - executed) {
+            const AotBlock& block = program.blocks[b];
+#ifdef CHIP8_STATS
+            StatCounters& counters = stat_counters();
+            for (uint16_t i=0; i<block.len; i++)
+                stat_add(counters.ops[stat_at[block.start + 2 * i]], 1);
+#endif
+            chip8.program_counter = block.code(state);
+            executed += block.len;
+        }
+        else {
+            executed += fallback.run_block(n - executed);
+        }
+    }
+    return executed;
+}
+
+void AotEngine::on_write(uint16_t addr, uint16_t len) {
+    fallback.on_write(addr, len);
+
+    int first = addr;
+    int last  = std::min(int(addr) + int(len) - 1, 0xFFF);
+
+    bool hit = false;
+    for (int a=first; a<=last; a++)
+        hit |= code_bytes[a];
+    if (hit)
+        verify(first, last);
+}
+
+// a block is live while memory still holds the bytes it was compiled from -
+// so one the program overwrites & later puts back comes back too
+void AotEngine::verify(int first, int last) {
+    for (size_t i=0; i<program.blocks.size(); i++) {
+        const AotBlock& block = program.blocks[i];
+        int end = block.start + 2 * block.len;
+        if (block.start > last || end <= first)
+            continue;
+
+        size_t at = block.start - 0x200;
+        bool same = block.start >= 0x200 && end - 0x200 <= int(program.image.size())
+                 && std::equal(&chip8.memory[block.start], &chip8.memory[end], &program.image[at]);
+        block_at[block.start] = same ? int32_t(i) : -1;
+    }
+}
@@ -0,0 +1,581 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "chip8.hh"
+#include "quirks.hh"
+#include "romdb.hh"
+
+// Ahead-of-time recompiler. Finds the code in a ROM by following its control
+// flow from 0x200 - through jumps, calls & the addresses they return to, and
+// both ways out of every skip - splits it into basic blocks, and writes a C++
+// file with one function per block for AotEngine (aot.hh) to run.
+//
+// Register ops are written out on locals holding the V registers & I, so the
+// compiler can keep them in host registers through a block; everything else
+// calls the Chip8 member function the interpreters would. Code only reached
+// through BNNN is never found & FX0A is never recompiled - both are left to
+// the interpreter at run time.
+
+// how an instruction leaves the straight line
+enum class Flow {
+    Next,           // on to the next instruction
+    Jump,           // 1NNN
+    Call,           // 2NNN - to NNN, returns to the next instruction
+    Return,         // 00EE
+    Skip,           // 3XNN 4XNN 5XY0 9XY0 EX9E EXA1 - the next instruction or the one after
+    Computed,       // BNNN - target only known at run time
+    Stay,           // 00FD - never leaves
+    Write,          // FX33 FX55 - writes memory, may rewrite the code after it
+    Interpreted,    // FX0A - waits on the frontend, never recompiled
+};
+
+static Flow flow_of(uint16_t inst) {
+    switch (inst >> 12) {
+    case 0x0:
+        if (inst == 0x00EE)
+            return Flow::Return;
+        if (inst == 0x00FD)
+            return Flow::Stay;
+        return Flow::Next;
+    case 0x1:    return Flow::Jump;
+    case 0x2:    return Flow::Call;
+    case 0x3:
+    case 0x4:
+    case 0x5:
+    case 0x9:    return Flow::Skip;
+    case 0xB:    return Flow::Computed;
+    case 0xE:
+        if ((inst & 0xFF) == 0x9E || (inst & 0xFF) == 0xA1)
+            return Flow::Skip;
+        return Flow::Next;
+    case 0xF:
+        if ((inst & 0xFF) == 0x0A)
+            return Flow::Interpreted;
+        if ((inst & 0xFF) == 0x33 || (inst & 0xFF) == 0x55)
+            return Flow::Write;
+        return Flow::Next;
+    }
+    return Flow::Next;
+}
+
+struct Block {
+    int start;
+    int len;        // instructions
+};
+
+class Recompiler {
+    std::array<uint8_t, 4096> memory{};
+    std::bitset<4096> visited;      // decoded as the start of an instruction
+    std::bitset<4096> leader;       // starts a basic block
+    std::vector<Block> blocks;
+
+    // last address an instruction fits at inside the ROM - memory past the
+    // image can't be checked against it at run time, so it's never recompiled
+    int last;
+
+    bool shift_vy;
+    bool jump_vx;
+
+    // the block being written
+    std::FILE* out;
+    uint16_t used;          // V registers held in locals
+    bool uses_index;        // I held in a local
+
+    uint16_t inst_at(int addr) const {
+        return (memory[addr] << 8) | memory[addr + 1];
+    }
+
+    void discover();
+    void split();
+
+    void scan(const Block&);
+    void line(int, char const*, ...) __attribute__((format(printf, 3, 4)));
+    void spill();
+    void reload();
+    void call(int, char const*, ...) __attribute__((format(printf, 3, 4)));
+    void body(int);
+    void leave(int);
+    void emit_block(const Block&);
+
+public:
+    Recompiler(std::span<const uint8_t>, uint8_t);
+
+    size_t block_count() { return blocks.size(); }
+    size_t inst_count();
+
+    void emit(std::FILE*, std::span<const uint8_t>, uint8_t, char const*);
+};
+
+Recompiler::Recompiler(std::span<const uint8_t> rom, uint8_t quirks) : last(0x200 + int(rom.size()) - 2), shift_vy(quirks & 1), jump_vx(quirks & 2) {
+    std::copy(rom.begin(), rom.end(), memory.begin() + 0x200);
+    discover();
+    split();
+}
+
+size_t Recompiler::inst_count() {
+    size_t count = 0;
+    for (const Block& block : blocks)
+        count += block.len;
+    return count;
+}
+
+//////////////////////////////////////////////////
+//                 Control flow                 //
+//////////////////////////////////////////////////
+
+// recursive descent from 0x200 - every address reached in the ROM is decoded
+// once, running off its end or jumping out of it is left to the interpreter
+void Recompiler::discover() {
+    std::vector<int> work;
+
+    auto branch = [&](int target) {
+        if (target >= 0x200 && target <= last) {
+            leader[target] = true;
+            work.push_back(target);
+        }
+    };
+    branch(0x200);
+
+    while (!work.empty()) {
+        int addr = work.back();
+        work.pop_back();
+
+        for (; addr <= last; addr += 2) {
+            // falling into code already decoded - it starts a block of its own
+            if (visited[addr]) {
+                leader[addr] = true;
+                break;
+            }
+            visited[addr] = true;
+
+            uint16_t inst = inst_at(addr);
+            Flow flow = flow_of(inst);
+            if (flow == Flow::Next)
+                continue;
+
+            switch (flow) {
+            case Flow::Jump:           branch(inst & 0xFFF);                       break;
+            case Flow::Call:           branch(inst & 0xFFF);  branch(addr + 2);    break;
+            case Flow::Skip:           branch(addr + 2);      branch(addr + 4);    break;
+            case Flow::Write:          branch(addr + 2);                           break;
+            case Flow::Interpreted:    branch(addr + 2);                           break;
+            default:                                                               break;
+            }
+            break;
+        }
+    }
+}
+
+// a block runs from a leader up to & including the first instruction that
+// leaves the straight line, stopping short of the next leader or an FX0A
+void Recompiler::split() {
+    for (int start=0x200; start<=last; start++) {
+        if (!leader[start] || flow_of(inst_at(start)) == Flow::Interpreted)
+            continue;
+
+        Block block{start, 0};
+        for (int addr=start; addr<=last; addr+=2) {
+            Flow flow = flow_of(inst_at(addr));
+            if (flow == Flow::Interpreted || (addr != start && leader[addr]))
+                break;
+            block.len++;
+            if (flow != Flow::Next)
+                break;
+        }
+        blocks.push_back(block);
+    }
+}
+
+//////////////////////////////////////////////////
+//                     Code                     //
+//////////////////////////////////////////////////
+
+// the registers the block's own code reads or writes - call-outs work on the
+// machine's, so these are written back before & reloaded after each one
+void Recompiler::scan(const Block& block) {
+    used = 0;
+    uses_index = false;
+    for (int i=0; i<block.len; i++) {
+        uint16_t inst = inst_at(block.start + 2 * i);
+        int x = (inst >> 8) & 0xF;
+        int y = (inst >> 4) & 0xF;
+        switch (inst >> 12) {
+        case 0x3:
+        case 0x4:
+        case 0x6:
+        case 0x7:
+        case 0xE:    used |= 1 << x;                                break;
+        case 0x5:
+        case 0x9:    used |= (1 << x) | (1 << y);                   break;
+        case 0x8:    used |= (1 << x) | (1 << y) | (1 << 0xF);      break;
+        case 0xA:    uses_index = true;                             break;
+        case 0xB:    used |= 1 << (jump_vx ? x : 0);                break;
+        case 0xF:
+            if ((inst & 0xFF) == 0x1E) {
+                used |= 1 << x;
+                uses_index = true;
+            }
+            break;
+        }
+    }
+}
+
+// one statement, commented with the instruction it came from
+void Recompiler::line(int addr, char const* format, ...) {
+    char text[128];
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    std::fprintf(out, "    %-56s// %03X  %04X\n", text, addr, inst_at(addr));
+}
+
+void Recompiler::spill() {
+    for (int r=0; r<16; r++) {
+        if (used & (1 << r))
+            std::fprintf(out, "    v[0x%X] = V%X;\n", r, r);
+    }
+    if (uses_index)
+        std::fprintf(out, "    s.index = I;\n");
+}
+
+void Recompiler::reload() {
+    for (int r=0; r<16; r++) {
+        if (used & (1 << r))
+            std::fprintf(out, "    V%X = v[0x%X];\n", r, r);
+    }
+    if (uses_index)
+        std::fprintf(out, "    I = s.index;\n");
+}
+
+// a Chip8 member function, on the machine's own registers
+void Recompiler::call(int addr, char const* format, ...) {
+    char text[128];
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    spill();
+    std::fprintf(out, "    s.chip8.%-48s// %03X  %04X\n", text, addr, inst_at(addr));
+    reload();
+}
+
+// an instruction that carries on to the next one
+void Recompiler::body(int addr) {
+    uint16_t inst = inst_at(addr);
+    int x = (inst >> 8) & 0xF;
+    int y = (inst >> 4) & 0xF;
+    int n = inst & 0xF;
+    int nn = inst & 0xFF;
+    int nnn = inst & 0xFFF;
+
+    switch (inst >> 12) {
+    case 0x0:
+        switch (nnn) {
+        case 0x0E0:    call(addr, "disp_clear();");                 return;
+        case 0x0FB:    call(addr, "scroll_right();");               return;
+        case 0x0FC:    call(addr, "scroll_left();");                return;
+        case 0x0FE:    call(addr, "set_hires(false);");             return;
+        case 0x0FF:    call(addr, "set_hires(true);");              return;
+        }
+        if ((nnn & 0xFF0) == 0x0C0)
+            call(addr, "scroll_down(%d);", n);
+        else if ((nnn & 0xFF0) == 0x0D0)
+            call(addr, "scroll_up(%d);", n);
+        else
+            line(addr, "// 0NNN - ignored");
+        return;
+
+    case 0x6:    line(addr, "V%X = 0x%02X;", x, nn);                return;
+    case 0x7:    line(addr, "V%X += 0x%02X;", x, nn);               return;
+
+    case 0x8:
+        switch (n) {
+        case 0x0:    line(addr, "V%X = V%X;", x, y);                return;
+        case 0x1:    line(addr, "V%X |= V%X;", x, y);               return;
+        case 0x2:    line(addr, "V%X &= V%X;", x, y);               return;
+        case 0x3:    line(addr, "V%X ^= V%X;", x, y);               return;
+        case 0x4:    line(addr, "{ int r = V%X + V%X; V%X = r; VF = r > 0xFF; }", x, y, x);                 return;
+        case 0x5:    line(addr, "{ uint8_t a = V%X, b = V%X; V%X = a - b; VF = a >= b; }", x, y, x);        return;
+        case 0x7:    line(addr, "{ uint8_t a = V%X, b = V%X; V%X = b - a; VF = b >= a; }", x, y, x);        return;
+        case 0x6:
+            if (shift_vy)
+                line(addr, "{ V%X = V%X; uint8_t f = V%X & 1; V%X >>= 1; VF = f; }", x, y, x, x);
+            else
+                line(addr, "{ uint8_t f = V%X & 1; V%X >>= 1; VF = f; }", x, x);
+            return;
+        case 0xE:
+            if (shift_vy)
+                line(addr, "{ V%X = V%X; uint8_t f = V%X >> 7; V%X <<= 1; VF = f; }", x, y, x, x);
+            else
+                line(addr, "{ uint8_t f = V%X >> 7; V%X <<= 1; VF = f; }", x, x);
+            return;
+        }
+        line(addr, "// 8XY%X - ignored", n);
+        return;
+
+    case 0xA:    line(addr, "I = 0x%03X;", nnn);                    return;
+    case 0xC:    call(addr, "gen_rand(%d, 0x%02X);", x, nn);        return;
+    case 0xD:    call(addr, "draw(%d, %d, %d);", x, y, n);          return;
+
+    case 0xF:
+        switch (nn) {
+        case 0x01:    call(addr, "select_planes(%d);", x);          return;
+        case 0x07:    call(addr, "get_delay(%d);", x);              return;
+        case 0x15:    call(addr, "set_delay(%d);", x);              return;
+        case 0x18:    call(addr, "set_sound(%d);", x);              return;
+        case 0x1E:    line(addr, "I += V%X;", x);                   return;
+        case 0x29:    call(addr, "sprite_index(%d);", x);           return;
+        case 0x30:    call(addr, "big_sprite_index(%d);", x);       return;
+        case 0x65:    call(addr, "reg_load<Q>(%d);", x);            return;
+        }
+        line(addr, "// FX%02X - ignored", nn);
+        return;
+    }
+    line(addr, "// %04X - ignored", inst);
+}
+
+// the instruction that ends a block - returns the next program counter
+void Recompiler::leave(int addr) {
+    uint16_t inst = inst_at(addr);
+    int x = (inst >> 8) & 0xF;
+    int y = (inst >> 4) & 0xF;
+    int nn = inst & 0xFF;
+    int nnn = inst & 0xFFF;
+
+    switch (flow_of(inst)) {
+    case Flow::Jump:
+        spill();
+        line(addr, "return 0x%03X;", nnn);
+        return;
+
+    // the call & return go through Chip8 for the stack, with the program
+    // counter where the interpreter would have it
+    case Flow::Call:
+        spill();
+        line(addr, "s.chip8.jump(0x%03X);", addr + 2);
+        line(addr, "s.chip8.subroutine_call(0x%03X);", nnn);
+        line(addr, "return s.chip8.get_pc();");
+        return;
+    case Flow::Return:
+        spill();
+        line(addr, "s.chip8.jump(0x%03X);", addr + 2);
+        line(addr, "s.chip8.subroutine_return();");
+        line(addr, "return s.chip8.get_pc();");
+        return;
+
+    case Flow::Skip: {
+        char cond[64];
+        switch (inst >> 12) {
+        case 0x3:    std::snprintf(cond, sizeof(cond), "V%X == 0x%02X", x, nn);                break;
+        case 0x4:    std::snprintf(cond, sizeof(cond), "V%X != 0x%02X", x, nn);                break;
+        case 0x5:    std::snprintf(cond, sizeof(cond), "V%X == V%X", x, y);                    break;
+        case 0x9:    std::snprintf(cond, sizeof(cond), "V%X != V%X", x, y);                    break;
+        default:
+            std::snprintf(cond, sizeof(cond), "%ss.io.key_is_pressed(V%X)", nn == 0x9E ? "" : "!", x);
+            break;
+        }
+        line(addr, "bool skip = %s;", cond);
+        spill();
+        line(addr, "return skip ? 0x%03X : 0x%03X;", addr + 4, addr + 2);
+        return;
+    }
+
+    case Flow::Computed:
+        spill();
+        line(addr, "return 0x%03X + V%X;", nnn, jump_vx ? x : 0);
+        return;
+
+    case Flow::Stay:
+        spill();
+        line(addr, "return 0x%03X;", addr);
+        return;
+
+    case Flow::Write:
+        call(addr, (inst & 0xFF) == 0x33 ? "bcd(%d);" : "reg_dump<Q>(%d);", x);
+        line(addr, "return 0x%03X;", addr + 2);
+        return;
+
+    default:
+        body(addr);
+        spill();
+        std::fprintf(out, "    return 0x%03X;\n", addr + 2);
+        return;
+    }
+}
+
+void Recompiler::emit_block(const Block& block) {
+    scan(block);
+
+    std::fprintf(out, "\n// %03X - %03X\n", block.start, block.start + 2 * block.len - 1);
+    std::fprintf(out, "static uint16_t block_%03X(AotState& s) {\n", block.start);
+    if (used)
+        std::fprintf(out, "    uint8_t* v = s.v;\n");
+    for (int r=0; r<16; r++) {
+        if (used & (1 << r))
+            std::fprintf(out, "    uint8_t V%X = v[0x%X];\n", r, r);
+    }
+    if (uses_index)
+        std::fprintf(out, "    uint16_t I = s.index;\n");
+    if (used || uses_index)
+        std::fprintf(out, "\n");
+
+    int last = block.start + 2 * (block.len - 1);
+    for (int addr=block.start; addr<last; addr+=2)
+        body(addr);
+    leave(last);
+
+    std::fprintf(out, "}\n");
+}
+
+void Recompiler::emit(std::FILE* file, std::span<const uint8_t> rom, uint8_t quirks, char const* name) {
+    out = file;
+
+    std::fprintf(out, "// %s - recompiled by chip8-aot, do not edit\n", name);
+    std::fprintf(out, "// %zu blocks, %zu instructions\n\n", block_count(), inst_count());
+    std::fprintf(out, "#include \"aot.hh\"\n\n");
+    std::fprintf(out, "using Q = Quirks<%s, %s, %s>;\n", quirks & 1 ? "true" : "false",
+                 quirks & 2 ? "true" : "false", quirks & 4 ? "true" : "false");
+
+    for (const Block& block : blocks)
+        emit_block(block);
+
+    // both arrays get at least one element - the spans say how many are real
+    std::fprintf(out, "\nstatic const uint8_t image[%zu] = {", std::max<size_t>(rom.size(), 1));
+    for (size_t i=0; i<rom.size(); i++)
+        std::fprintf(out, "%s0x%02X,", i % 16 ? " " : "\n    ", rom[i]);
+    std::fprintf(out, "\n};\n");
+
+    std::fprintf(out, "\nstatic const AotBlock blocks[%zu] = {\n", std::max<size_t>(blocks.size(), 1));
+    for (const Block& block : blocks)
+        std::fprintf(out, "    {0x%03X, %d, block_%03X},\n", block.start, block.len, block.start);
+    std::fprintf(out, "};\n");
+
+    std::fprintf(out, "\nextern const AotProgram aot_program = {\n"
+                      "    \"%s\", %d,\n"
+                      "    std::span<const uint8_t>(image, %zu),\n"
+                      "    std::span<const AotBlock>(blocks, %zu),\n"
+                      "};\n", name, quirks, rom.size(), blocks.size());
+}
+
+static void usage(char const* name) {
+    std::cerr << "usage: " << name << " <rom.ch8> [-o out.cc] [--quirks P] [--name N]\n"
+              << "  -o F         write the recompiled program to F (default standard output)\n"
+              << "  --quirks P   vip | chip48 | schip - the quirks compiled in (default the ROM\n"
+              << "               database's, otherwise none of the quirks)\n"
+              << "  --name N     name the program goes by (default the ROM file's stem)\n";
+}
+
+int main(int argc, char ** argv) {
+    char const* rom_arg = nullptr;
+    char const* out_path = nullptr;
+    char const* quirks_name = nullptr;
+    std::string name;
+
+    for (int i=1; i<argc; i++) {
+        if (!std::strcmp(argv[i], "-o") && i+1 < argc) {
+            out_path = argv[++i];
+        }
+        else if (!std::strcmp(argv[i], "--quirks") && i+1 < argc) {
+            quirks_name = argv[++i];
+        }
+        else if (!std::strcmp(argv[i], "--name") && i+1 < argc) {
+            name = argv[++i];
+        }
+        else if (argv[i][0] != '-' && !rom_arg) {
+            rom_arg = argv[i];
+        }
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!rom_arg) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::filesystem::path rom{rom_arg};
+    if (!std::filesystem::exists(rom)) {
+        std::cerr << "error: " << rom_arg << " does not exist\n";
+        return 1;
+    }
+    std::vector<uint8_t> rom_bytes = read_rom_file(rom);
+    if (name.empty())
+        name = rom.stem().string();
+    // it ends up in a string literal
+    for (char& c : name) {
+        if (c < ' ' || c > '~' || c == '"' || c == '\\')
+            c = '_';
+    }
+
+    uint8_t quirks = QuirksDefault::bits;
+    QuirkProfile profile;
+    if (quirks_name) {
+        if (!parse_quirk_profile(quirks_name, profile)) {
+            std::cerr << "error: unknown quirks " << quirks_name << "\n";
+            return 1;
+        }
+        quirks = quirk_profile_bits(profile);
+    }
+    else if (const RomInfo* known = rom_lookup(rom_hash(rom_bytes)); known && known->quirks >= 0) {
+        quirks = known->quirks;
+    }
+
+    Recompiler recompiler(rom_bytes, quirks);
+
+    std::FILE* out = out_path ? std::fopen(out_path, "w") : stdout;
+    if (!out) {
+        std::cerr << "error: could not write " << out_path << "\n";
+        return 1;
+    }
+    recompiler.emit(out, rom_bytes, quirks, name.c_str());
+    if ((out_path ? std::fclose(out) : std::fflush(out)) != 0) {
+        std::cerr << "error: could not write " << (out_path ? out_path : "standard output") << "\n";
+        return 1;
+    }
+
+    std::cerr << name << ": " << recompiler.block_count() << " blocks, " << recompiler.inst_count()
+              << " instructions recompiled\n";
+    return 0;
+}
@@ -0,0 +1,76 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <algorithm>
+#include <string>
+
+#include "SDL3/SDL_hints.h"
+#include "SDL3/SDL_init.h"
+
+#include "audio.hh"
+
+// one buffer of scheduling latency on top of the device's own buffer
+AudioOutput::AudioOutput(int buffer)
+    : stream(nullptr), beeper(sample_rate, std::max(buffer, 1)) {
+    if (buffer <= 0 || !SDL_InitSubSystem(SDL_INIT_AUDIO))
+        return;
+
+    // a hint, the device may still pick its own size
+    SDL_SetHint(SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES, std::to_string(buffer).c_str());
+
+    SDL_AudioSpec spec{SDL_AUDIO_F32, 1, sample_rate};
+    stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec, feed, this);
+    if (!stream) {
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        return;
+    }
+    SDL_ResumeAudioStreamDevice(stream);
+}
+
+AudioOutput::~AudioOutput() {
+    if (stream) {
+        SDL_DestroyAudioStream(stream);
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    }
+}
+
+Beeper* AudioOutput::get_beeper() {
+    return stream ? &beeper : nullptr;
+}
+
+// SDL audio thread - additional is in bytes
+void SDLCALL AudioOutput::feed(void* userdata, SDL_AudioStream* stream, int additional, int) {
+    AudioOutput& out = *static_cast<AudioOutput*>(userdata);
+    int samples = additional / int(sizeof(float));
+    while (samples > 0) {
+        int n = std::min<int>(samples, out.scratch.size());
+        out.beeper.render(out.scratch.data(), n);
+        SDL_PutAudioStreamData(stream, out.scratch.data(), n * int(sizeof(float)));
+        samples -= n;
+    }
+}
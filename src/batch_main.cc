@@ -0,0 +1,355 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "chip8.hh"
+#include "cli.hh"
+#include "engine.hh"
+#include "headless.hh"
+#include "scheduler.hh"
+#include "thread_pool.hh"
+
+// Runs a list of ROM / configuration jobs across every core & writes one JSON
+// line of results per job, in job list order.
+//
+// Job list - one job per line, blank lines & # comments ignored:
+//
+//     <rom.ch8>  <budget>  [quirks]  [seed]
+//
+//     budget - instructions to run, or N followed by f for N 60 Hz frames
+//              (timers tick between frames, nothing sleeps)
+//     quirks - vip, chip48, schip, comma separated shift_vy, jump_vx,
+//              load_inc, or - for none
+//     seed   - CXNN random seed (default 0)
+
+namespace {
+
+struct Job {
+    std::string rom;
+    uint64_t budget;
+    bool frames;
+    bool shift_use_vy;
+    bool jump_offset_vx;
+    bool store_load_i_inc;
+    uint64_t seed;
+};
+
+struct Result {
+    std::string error;          // empty - job ran
+    bool end_of_mem;
+    uint64_t executed;
+    uint64_t frames;
+    uint16_t pc;
+    uint16_t index;
+    uint8_t delay_timer;
+    uint8_t sound_timer;
+    uint8_t var_regs[16];
+    uint64_t display_hash;
+    double seconds;
+};
+
+bool parse_quirks(const std::string& text, Job& job) {
+    job.shift_use_vy = job.jump_offset_vx = job.store_load_i_inc = false;
+    if (text == "-")
+        return true;
+
+    QuirkProfile profile;
+    if (parse_quirk_profile(text, profile)) {
+        uint8_t bits = quirk_profile_bits(profile);
+        job.shift_use_vy = bits & 1;
+        job.jump_offset_vx = bits & 2;
+        job.store_load_i_inc = bits & 4;
+        return true;
+    }
+
+    std::stringstream list(text);
+    std::string quirk;
+    while (std::getline(list, quirk, ',')) {
+        if (quirk == "shift_vy")
+            job.shift_use_vy = true;
+        else if (quirk == "jump_vx")
+            job.jump_offset_vx = true;
+        else if (quirk == "load_inc")
+            job.store_load_i_inc = true;
+        else
+            return false;
+    }
+    return true;
+}
+
+// returns 0 - ok,  1 - couldn't open, or a malformed line (reported on stderr)
+int read_jobs(char const* path, std::vector<Job>& jobs) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "error: could not open " << path << "\n";
+        return 1;
+    }
+
+    std::string line;
+    for (int line_num=1; std::getline(in, line); line_num++) {
+        line = line.substr(0, line.find('#'));
+
+        std::stringstream fields(line);
+        std::string rom, budget, quirks = "-", seed = "0";
+        if (!(fields >> rom))
+            continue;
+        fields >> budget >> quirks >> seed;
+
+        Job job{};
+        job.rom = rom;
+
+        char* end = nullptr;
+        job.budget = std::strtoull(budget.c_str(), &end, 0);
+        job.frames = (*end == 'f');
+        if (budget.empty() || end == budget.c_str() || *(end + job.frames) != '\0'
+            || !parse_quirks(quirks, job) || !parse_number(seed, job.seed))
+        {
+            std::cerr << "error: " << path << ":" << line_num << ": bad job line\n";
+            return 1;
+        }
+        jobs.push_back(job);
+    }
+    return 0;
+}
+
+// FNV-1a over the display rows, so two runs can be compared by one number -
+// only the words the current resolution covers, & plane 2 only if anything is
+// on it, so a classic 64x32 display hashes the same as it always has
+uint64_t display_hash(const Screen& display) {
+    uint64_t hash = 0xCBF29CE484222325;
+    for (int p=0; p<Screen::plane_count; p++) {
+        if (p > 0 && display.planes[p] == Screen::Plane{})
+            continue;
+        for (int y=0; y<display.height(); y++) {
+            for (int w=0; w<display.width() / 64; w++) {
+                uint64_t word = display.planes[p][y][w];
+                for (int b=0; b<8; b++) {
+                    hash ^= (word >> (b * 8)) & 0xFF;
+                    hash *= 0x100000001B3;
+                }
+            }
+        }
+    }
+    return hash;
+}
+
+void run_job(const Job& job, const std::vector<uint8_t>& rom, char const* engine_name, Result& result) {
+    auto start = std::chrono::steady_clock::now();
+
+    Chip8 chip8(rom);
+    chip8.config_shift(job.shift_use_vy);
+    chip8.config_jump_offset(job.jump_offset_vx);
+    chip8.config_store_load_inc(job.store_load_i_inc);
+    chip8.seed_rand(job.seed);
+
+    HeadlessFrontend io{};
+    std::unique_ptr<Engine> engine = make_engine(engine_name, chip8, io);
+
+    result.executed = 0;
+    result.frames = 0;
+    if (job.frames) {
+        Scheduler scheduler(chip8, *engine, io);
+        while (scheduler.get_frame_count() < job.budget && !chip8.end_of_mem())
+            result.executed += scheduler.run_frame();
+        result.frames = scheduler.get_frame_count();
+    }
+    else {
+        result.executed = engine->run(job.budget);
+    }
+
+    result.end_of_mem = chip8.end_of_mem();
+    result.pc = chip8.get_pc();
+    result.index = chip8.get_index();
+    result.delay_timer = chip8.get_delay_timer();
+    result.sound_timer = chip8.get_sound_timer();
+    for (int i=0; i<16; i++)
+        result.var_regs[i] = chip8.get_var_reg(i);
+    result.display_hash = display_hash(chip8.get_display());
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result.seconds = elapsed.count();
+}
+
+void write_json_string(std::FILE* out, const std::string& text) {
+    std::fputc('"', out);
+    for (unsigned char c : text) {
+        if (c == '"' || c == '\\')
+            std::fprintf(out, "\\%c", c);
+        else if (c < 0x20)
+            std::fprintf(out, "\\u%04x", c);
+        else
+            std::fputc(c, out);
+    }
+    std::fputc('"', out);
+}
+
+void write_result(std::FILE* out, size_t num, const Job& job, const Result& result) {
+    std::fprintf(out, "{\"job\":%zu,\"rom\":", num);
+    write_json_string(out, job.rom);
+
+    if (!result.error.empty()) {
+        std::fprintf(out, ",\"status\":\"error\",\"error\":");
+        write_json_string(out, result.error);
+        std::fprintf(out, "}\n");
+        return;
+    }
+
+    std::fprintf(out, ",\"status\":\"%s\",\"instructions\":%llu",
+                 result.end_of_mem ? "end_of_mem" : "ok", (unsigned long long)result.executed);
+    if (job.frames)
+        std::fprintf(out, ",\"frames\":%llu", (unsigned long long)result.frames);
+
+    std::fprintf(out, ",\"pc\":%u,\"i\":%u,\"dt\":%u,\"st\":%u,\"v\":[",
+                 result.pc, result.index, result.delay_timer, result.sound_timer);
+    for (int i=0; i<16; i++)
+        std::fprintf(out, "%s%u", i ? "," : "", result.var_regs[i]);
+    std::fprintf(out, "],\"display_hash\":\"%016llx\",\"seconds\":%.6f}\n",
+                 (unsigned long long)result.display_hash, result.seconds);
+}
+
+void usage(char const* name) {
+    std::cerr << "usage: " << name << " <jobs.txt> [--threads N] [--engine E] [--out F]\n"
+              << "  --threads N  worker threads (default one per hardware thread)\n"
+              << "  --engine E   switch | dispatch | jit (default dispatch)\n"
+              << "  --out F      write results to F instead of stdout\n"
+              << "job lines:  <rom.ch8> <instructions | frames f> [quirks] [seed]\n"
+              << "  quirks - vip | chip48 | schip, comma separated shift_vy, jump_vx, load_inc, or -\n";
+}
+
+}
+
+int main(int argc, char ** argv) {
+    char const* jobs_arg = nullptr;
+    char const* engine_name = "dispatch";
+    char const* out_path = nullptr;
+    unsigned threads = 0;
+
+    for (int i=1; i<argc; i++) {
+        if (!std::strcmp(argv[i], "--threads") && i+1 < argc) {
+            threads = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (!std::strcmp(argv[i], "--engine") && i+1 < argc) {
+            engine_name = argv[++i];
+        }
+        else if (!std::strcmp(argv[i], "--out") && i+1 < argc) {
+            out_path = argv[++i];
+        }
+        else if (argv[i][0] != '-' && !jobs_arg) {
+            jobs_arg = argv[i];
+        }
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!jobs_arg) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // catch a bad engine name once up front rather than in every job
+    {
+        Chip8 probe(std::span<const uint8_t>{});
+        HeadlessFrontend io{};
+        if (!make_engine(engine_name, probe, io)) {
+            std::cerr << "error: unknown engine " << engine_name << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<Job> jobs;
+    if (read_jobs(jobs_arg, jobs))
+        return 1;
+
+    // each distinct ROM is read once, jobs share the image read-only
+    std::map<std::string, std::vector<uint8_t>> roms;
+    std::map<std::string, bool> rom_ok;
+    for (const Job& job : jobs) {
+        if (!roms.count(job.rom)) {
+            rom_ok[job.rom] = std::filesystem::exists(job.rom);
+            roms[job.rom] = read_rom_file(job.rom);
+        }
+    }
+
+    std::vector<Result> results(jobs.size());
+    auto start = std::chrono::steady_clock::now();
+
+    WorkStealingPool pool(threads);
+    for (size_t i=0; i<jobs.size(); i++) {
+        if (!rom_ok[jobs[i].rom]) {
+            results[i].error = "could not read rom";
+            continue;
+        }
+
+        const std::vector<uint8_t>& rom = roms[jobs[i].rom];
+        pool.submit([&, i] {
+            run_job(jobs[i], rom, engine_name, results[i]);
+        });
+    }
+    pool.wait();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::FILE* out = out_path ? std::fopen(out_path, "w") : stdout;
+    if (!out) {
+        std::cerr << "error: could not write " << out_path << "\n";
+        return 1;
+    }
+
+    uint64_t total = 0;
+    int failed = 0;
+    for (size_t i=0; i<jobs.size(); i++) {
+        write_result(out, i, jobs[i], results[i]);
+        total += results[i].executed;
+        failed += !results[i].error.empty();
+    }
+    if (out != stdout && std::fclose(out) != 0) {
+        std::cerr << "error: could not write " << out_path << "\n";
+        return 1;
+    }
+
+    std::fprintf(stderr, "%zu jobs (%d failed) on %zu threads, %llu instructions in %.3f s (%.0f inst/sec)\n",
+                 jobs.size(), failed, pool.size(), (unsigned long long)total, elapsed.count(),
+                 elapsed.count() > 0 ? total / elapsed.count() : 0.0);
+
+    return failed ? 1 : 0;
+}
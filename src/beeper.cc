@@ -0,0 +1,132 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#include "beeper.hh"
+
+Beeper::Beeper(int sample_rate, int latency, float tone, float volume)
+    : sent(false), sample_rate(sample_rate), latency(latency), volume(volume),
+      phase(0.0), phase_step(double(tone) / sample_rate),
+      clock(0), origin(0), anchored(false), on(false), env(0) {
+    // square wave from its odd harmonics, stopping short of Nyquist so
+    // nothing aliases, with Lanczos sigma factors to tame the ringing
+    int harmonics = 0;
+    while ((2 * harmonics + 1) * tone < sample_rate / 2.0f)
+        harmonics++;
+
+    wave.assign(table_size + 1, 0.0f);
+    for (int h=0; h<harmonics; h++) {
+        int k = 2 * h + 1;
+        double x = std::numbers::pi * k / (2 * harmonics + 1);
+        double sigma = std::sin(x) / x;
+        for (size_t i=0; i<table_size; i++)
+            wave[i] += float(sigma * std::sin(2 * std::numbers::pi * k * i / table_size) / k);
+    }
+    float peak = 0.0f;
+    for (size_t i=0; i<table_size; i++)
+        peak = std::max(peak, std::abs(wave[i]));
+    for (size_t i=0; i<table_size; i++)
+        wave[i] = peak > 0.0f ? wave[i] / peak : 0.0f;
+    wave[table_size] = wave[0];
+
+    // 2 ms fade in / out
+    size_t ramp_len = std::max(1, sample_rate / 500);
+    ramp.resize(ramp_len + 1);
+    for (size_t i=0; i<=ramp_len; i++)
+        ramp[i] = float(0.5 - 0.5 * std::cos(std::numbers::pi * i / ramp_len));
+}
+
+void Beeper::update(uint64_t frame, bool state) {
+    if (state != sent && edges.push(BeeperEdge{frame, state}))
+        sent = state;
+}
+
+// sample an edge is heard at, re-anchoring if it's out of any sensible range
+int64_t Beeper::due(uint64_t frame) {
+    int64_t offset = int64_t(frame * sample_rate / 60);
+    int64_t at = origin + offset;
+    if (!anchored || at < clock - latency || at > clock + 4 * latency) {
+        origin = clock + latency - offset;
+        anchored = true;
+        at = clock + latency;
+    }
+    return at;
+}
+
+void Beeper::render(float* out, size_t n) {
+    size_t i = 0;
+    while (i < n) {
+        size_t until = n;
+        if (const BeeperEdge* edge = edges.peek()) {
+            int64_t at = due(edge->frame);
+            if (at <= clock) {
+                // starting from silence - start the period from the top
+                if (edge->on && env == 0)
+                    phase = 0.0;
+                on = edge->on;
+                BeeperEdge done;
+                edges.pop(done);
+                continue;
+            }
+            until = std::min(n, i + size_t(at - clock));
+        }
+        synth(out + i, until - i);
+        i = until;
+    }
+}
+
+void Beeper::synth(float* out, size_t n) {
+    clock += n;
+
+    // silent - the usual case
+    if (!on && env == 0) {
+        std::fill(out, out + n, 0.0f);
+        return;
+    }
+
+    size_t ramp_len = ramp.size() - 1;
+    for (size_t i=0; i<n; i++) {
+        if (on && env < ramp_len)
+            env++;
+        else if (!on && env > 0)
+            env--;
+
+        double pos = phase * table_size;
+        size_t k = size_t(pos);
+        float frac = float(pos - k);
+        float sample = wave[k] + (wave[k + 1] - wave[k]) * frac;
+        out[i] = sample * ramp[env] * volume;
+
+        phase += phase_step;
+        if (phase >= 1.0)
+            phase -= 1.0;
+    }
+}
@@ -30,71 +30,149 @@ freely, subject to the following restrictions:
 #include <array>
 #include <fstream>
 #include <cstdint>
-//#include <ctime>
-#include <iostream>
+#include <vector>
 
 #include "chip8.hh"
-
-Chip8::Chip8(std::filesystem::path rom_file) {
+#include "savestate.hh"
+#include "stats.hh"
+
+// save states & clones are plain copies
+static_assert(std::is_trivially_copyable_v<Chip8>);
+
+namespace {
+
+constexpr std::array<uint8_t, 80> font = {
+    0x60, 0xB0, 0xD0, 0x90, 0x60,   // 0
+    0x20, 0x60, 0x20, 0x20, 0x70,   // 1
+    0x60, 0x90, 0x20, 0x40, 0xF0,   // 2
+    0xE0, 0x10, 0x60, 0x10, 0xE0,   // 3
+    0x20, 0x60, 0xA0, 0xF0, 0x20,   // 4
+    0xF0, 0x80, 0xE0, 0x10, 0xE0,   // 5
+    0x60, 0x80, 0xE0, 0x90, 0x60,   // 6
+    0xF0, 0x10, 0x20, 0x40, 0x40,   // 7
+    0x60, 0x90, 0x60, 0x90, 0x60,   // 8
+    0x60, 0x90, 0x70, 0x10, 0x60,   // 9
+    0x60, 0x90, 0xF0, 0x90, 0x90,   // A
+    0xE0, 0x90, 0xE0, 0x90, 0xE0,   // B
+    0x70, 0x80, 0x80, 0x80, 0x70,   // C
+    0xE0, 0x90, 0x90, 0x90, 0xE0,   // D
+    0xF0, 0x80, 0xE0, 0x80, 0xF0,   // E
+    0xF0, 0x80, 0xE0, 0x80, 0x80    // F
+};
+
+// SUPER-CHIP 8x10 digits for FX30, right after the small font
+constexpr uint16_t big_font_addr = 0x0A0;
+constexpr std::array<uint8_t, 160> big_font = {
+    0x3C, 0x7E, 0xE7, 0xC3, 0xC3, 0xC3, 0xC3, 0xE7, 0x7E, 0x3C,   // 0
+    0x18, 0x38, 0x58, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x3C,   // 1
+    0x3E, 0x7F, 0xC3, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xFF, 0xFF,   // 2
+    0x3C, 0x7E, 0xC3, 0x03, 0x0E, 0x0E, 0x03, 0xC3, 0x7E, 0x3C,   // 3
+    0x06, 0x0E, 0x1E, 0x36, 0x66, 0xC6, 0xFF, 0xFF, 0x06, 0x06,   // 4
+    0xFF, 0xFF, 0xC0, 0xC0, 0xFC, 0xFE, 0x03, 0xC3, 0x7E, 0x3C,   // 5
+    0x3E, 0x7C, 0xC0, 0xC0, 0xFC, 0xFE, 0xC3, 0xC3, 0x7E, 0x3C,   // 6
+    0xFF, 0xFF, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x60, 0x60,   // 7
+    0x3C, 0x7E, 0xC3, 0xC3, 0x7E, 0x7E, 0xC3, 0xC3, 0x7E, 0x3C,   // 8
+    0x3C, 0x7E, 0xC3, 0xC3, 0x7F, 0x3F, 0x03, 0x03, 0x3E, 0x7C,   // 9
+    0x18, 0x3C, 0x66, 0xC3, 0xC3, 0xFF, 0xFF, 0xC3, 0xC3, 0xC3,   // A
+    0xFC, 0xFE, 0xC3, 0xC3, 0xFE, 0xFE, 0xC3, 0xC3, 0xFE, 0xFC,   // B
+    0x3C, 0x7E, 0xC3, 0xC0, 0xC0, 0xC0, 0xC0, 0xC3, 0x7E, 0x3C,   // C
+    0xFC, 0xFE, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xFE, 0xFC,   // D
+    0xFF, 0xFF, 0xC0, 0xC0, 0xFC, 0xFC, 0xC0, 0xC0, 0xFF, 0xFF,   // E
+    0xFF, 0xFF, 0xC0, 0xC0, 0xFC, 0xFC, 0xC0, 0xC0, 0xC0, 0xC0    // F
+};
+
+}
+
+std::vector<uint8_t> read_rom_file(const std::filesystem::path& rom_file) {
+    std::vector<uint8_t> rom(4096 - 0x200);
+    std::ifstream in(rom_file, std::ios::binary);
+    in.read(reinterpret_cast<char*>(rom.data()), rom.size());
+    rom.resize(in.gcount());
+    return rom;
+}
+
+Chip8::Chip8(std::filesystem::path rom_file) : Chip8(read_rom_file(rom_file)) {}
+
+Chip8::Chip8(std::span<const uint8_t> rom) {
     // zero out all memory first
     std::fill(memory.begin(), memory.end(), 0);
-
-    uint8_t font[] = {
-        0x60, 0xB0, 0xD0, 0x90, 0x60,   // 0
-        0x20, 0x60, 0x20, 0x20, 0x70,   // 1
-        0x60, 0x90, 0x20, 0x40, 0xF0,   // 2
-        0xE0, 0x10, 0x60, 0x10, 0xE0,   // 3
-        0x20, 0x60, 0xA0, 0xF0, 0x20,   // 4
-        0xF0, 0x80, 0xE0, 0x10, 0xE0,   // 5
-        0x60, 0x80, 0xE0, 0x90, 0x60,   // 6
-        0xF0, 0x10, 0x20, 0x40, 0x40,   // 7
-        0x60, 0x90, 0x60, 0x90, 0x60,   // 8
-        0x60, 0x90, 0x70, 0x10, 0x60,   // 9
-        0x60, 0x90, 0xF0, 0x90, 0x90,   // A
-        0xE0, 0x90, 0xE0, 0x90, 0xE0,   // B
-        0x70, 0x80, 0x80, 0x80, 0x70,   // C
-        0xE0, 0x90, 0x90, 0x90, 0xE0,   // D
-        0xF0, 0x80, 0xE0, 0x80, 0xF0,   // E
-        0xF0, 0x80, 0xE0, 0x80, 0x80    // F
-    };
+    display = {};
+    dirty_rows = all_rows;
+    plane_mask = 1;
+    std::fill(var_regs.begin(), var_regs.end(), 0);
+    index_register = 0;
+    std::fill(stack.begin(), stack.end(), 0);
+    stack_pointer = 0;
+    delay_timer = 0;
+    sound_timer = 0;
 
     // initialize font in memory
-    for (int i=0; i<80; i++) {
-        memory[i+0x50] = font[i];
-    }
+    std::copy(font.begin(), font.end(), &memory[0x50]);
+    std::copy(big_font.begin(), big_font.end(), &memory[big_font_addr]);
 
     // initialize program counter to 0x200
     program_counter = 0x200;
 
     // config defaults
     inst_per_sec = 700;
+    shift_use_vy = false;
+    jump_offset_vx = false;
+    store_load_i_inc = false;
+    seed_rand(0);
 
-    // srand
-    srand(time(NULL));
-
-    // read & load rom to memory (starting @ address 0x200)
-    std::ifstream rom(rom_file, std::ios::binary);
-    rom.read(reinterpret_cast<char*>(&memory[0x200]), memory.size()-0x200);
+    // load rom to memory (starting @ address 0x200), anything past the end of memory is dropped
+    size_t rom_size = std::min(rom.size(), memory.size() - 0x200);
+    std::copy_n(rom.begin(), rom_size, &memory[0x200]);
 
     // init block (no block yet)
     block_state = 0;
+
+    watcher = nullptr;
+    call_watcher = nullptr;
+}
+
+Chip8 Chip8::clone() const {
+    Chip8 copy = *this;
+    copy.watcher = nullptr;
+    copy.call_watcher = nullptr;
+    return copy;
+}
+
+void Chip8::clone_into(Chip8& dst) const {
+    MemoryWatcher* dst_watcher = dst.watcher;
+    CallWatcher* dst_call_watcher = dst.call_watcher;
+    dst = *this;
+    dst.watcher = dst_watcher;
+    dst.call_watcher = dst_call_watcher;
+
+    // whatever dst's engine had decoded is gone
+    if (dst_watcher)
+        dst_watcher->on_write(0, memory.size());
 }
 
 //////////////////////////////////////////////////
 //                    Access                    //
 //////////////////////////////////////////////////
 
-std::array<uint64_t, 32> Chip8::get_display() {
+const Screen& Chip8::get_display() {
     return display;
 }
 
+uint64_t Chip8::take_dirty_rows() {
+    uint64_t rows = dirty_rows;
+    dirty_rows = 0;
+    return rows;
+}
+
 bool Chip8::end_of_mem() {
     return (program_counter > 0xFFF);
 }
 
+// an instruction at 0xFFF takes its second byte from 0x000, as every engine does
 uint16_t Chip8::get_inst() {
-    uint8_t first_byte = memory[program_counter++];
-    uint8_t last_byte  = memory[program_counter++];
+    uint8_t first_byte = memory[program_counter & 0xFFF];
+    uint8_t last_byte  = memory[(program_counter + 1) & 0xFFF];
+    program_counter += 2;
     return (first_byte << 8) | last_byte;
 }
 
@@ -110,6 +188,82 @@ int Chip8::get_timing() {
     return inst_per_sec;
 }
 
+// 60 Hz - both timers count down to 0
+void Chip8::tick_timers() {
+    if (delay_timer > 0)
+        delay_timer--;
+    if (sound_timer > 0)
+        sound_timer--;
+}
+
+
+//////////////////////////////////////////////////
+//                 Save States                  //
+//////////////////////////////////////////////////
+
+void Chip8::save(SaveState& state) {
+    state.magic = SaveState::magic_value;
+    state.version = SaveState::current_version;
+
+    state.memory = memory;
+    for (int p=0; p<Screen::plane_count; p++)
+        for (int r=0; r<Screen::max_height; r++)
+            for (int w=0; w<Screen::row_words; w++)
+                state.display[(p*Screen::max_height + r)*Screen::row_words + w] = display.planes[p][r][w];
+    state.stack = stack;
+    state.var_regs = var_regs;
+
+    state.index_register = index_register;
+    state.program_counter = program_counter;
+    state.delay_timer = delay_timer;
+    state.sound_timer = sound_timer;
+    state.stack_pointer = stack_pointer;
+    state.block_state = block_state;
+
+    state.inst_per_sec = inst_per_sec;
+    state.shift_use_vy = shift_use_vy;
+    state.jump_offset_vx = jump_offset_vx;
+    state.store_load_i_inc = store_load_i_inc;
+    state.hires = display.hires;
+    state.plane_mask = plane_mask;
+    std::fill(std::begin(state.reserved), std::end(state.reserved), 0);
+    state.rng_state = rng_state;
+}
+
+int Chip8::load(const SaveState& state) {
+    if (state.magic != SaveState::magic_value || state.version != SaveState::current_version)
+        return 1;
+
+    memory = state.memory;
+    for (int p=0; p<Screen::plane_count; p++)
+        for (int r=0; r<Screen::max_height; r++)
+            for (int w=0; w<Screen::row_words; w++)
+                display.planes[p][r][w] = state.display[(p*Screen::max_height + r)*Screen::row_words + w];
+    display.hires = state.hires;
+    plane_mask = state.plane_mask & 3;
+    stack = state.stack;
+    var_regs = state.var_regs;
+
+    index_register = state.index_register;
+    program_counter = state.program_counter;
+    delay_timer = state.delay_timer;
+    sound_timer = state.sound_timer;
+    stack_pointer = std::min<uint8_t>(state.stack_pointer, 16);
+    block_state = state.block_state;
+
+    inst_per_sec = state.inst_per_sec;
+    shift_use_vy = state.shift_use_vy;
+    jump_offset_vx = state.jump_offset_vx;
+    store_load_i_inc = state.store_load_i_inc;
+    rng_state = state.rng_state ? state.rng_state : 1;
+
+    // whole display needs presenting, anything decoded from memory is stale
+    dirty_rows = all_rows;
+    if (watcher)
+        watcher->on_write(0, memory.size());
+
+    return 0;
+}
 
 //////////////////////////////////////////////////
 //                Configurations                //
@@ -119,6 +273,21 @@ void Chip8::config_timing(int num) {
     inst_per_sec = num;
 }
 
+void Chip8::seed_rand(uint64_t seed) {
+    rng_state = mix_seed(seed);
+}
+
+uint64_t Chip8::mix_seed(uint64_t seed) {
+    // splitmix64 the seed so small / similar seeds still give unrelated streams
+    seed += 0x9E3779B97F4A7C15;
+    seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9;
+    seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EB;
+    seed ^= seed >> 31;
+
+    // xorshift state must never be zero
+    return seed ? seed : 1;
+}
+
 void Chip8::config_shift(bool set) {
     shift_use_vy = set;
 }
@@ -131,39 +300,159 @@ void Chip8::config_store_load_inc(bool set) {
     store_load_i_inc = set;
 }
 
+void Chip8::config_quirks(QuirkProfile profile) {
+    config_quirk_bits(quirk_profile_bits(profile));
+}
+
+void Chip8::config_quirk_bits(uint8_t bits) {
+    shift_use_vy = bits & 1;
+    jump_offset_vx = bits & 2;
+    store_load_i_inc = bits & 4;
+}
+
+uint8_t Chip8::get_quirks() {
+    return (shift_use_vy ? 1 : 0) | (jump_offset_vx ? 2 : 0) | (store_load_i_inc ? 4 : 0);
+}
+
 //////////////////////////////////////////////////
 //                   Display                    //
 //////////////////////////////////////////////////
 
 void Chip8::disp_clear() {
-    std::fill(display.begin(), display.end(), 0);
+    for (int p=0; p<Screen::plane_count; p++)
+        if (plane_mask & (1 << p))
+            display.planes[p] = {};
+    dirty_rows = all_rows;
 }
 
 void Chip8::draw(uint8_t x, uint8_t y, uint8_t n) {
-    size_t x_coord = var_regs[x] & 63;
-    size_t y_coord = var_regs[y] & 31;
-    uint64_t sprite_row;
-    uint64_t collision_test;
+    int width = display.width();
+    int height = display.height();
+    size_t x_coord = var_regs[x] & (width - 1);
+    size_t y_coord = var_regs[y] & (height - 1);
+
+    // n = 0 is a 16x16 sprite, 2 bytes a row
+    int bytes = n ? 1 : 2;
+    int rows = n ? n : 16;
+    uint16_t addr = index_register;
 
     // initialize flag reg VF to 0
     var_regs[15] = 0;
 
-    for (size_t i=0; i<n; i++) {
-        sprite_row = memory[index_register+i];
-        int shift = 56 - x_coord;
-        if (shift >= 0) {
-            sprite_row <<= shift;
-        } else {
-            sprite_row >>= shift * -1;
+    // sprites are clipped at the bottom edge
+    int visible = std::min<int>(rows, height - y_coord);
+
+    for (int p=0; p<Screen::plane_count; p++) {
+        if (!(plane_mask & (1 << p)))
+            continue;
+        Screen::Plane& plane = display.planes[p];
+
+        for (int i=0; i<visible; i++) {
+            uint64_t bits = memory[(addr + i*bytes) & 0xFFF];
+            if (bytes == 2)
+                bits = (bits << 8) | memory[(addr + i*bytes + 1) & 0xFFF];
+
+            // line the sprite row up across the row's two words - anything
+            // past the right edge falls off the end (or is dropped in lores)
+            uint64_t sprite = bits << (64 - 8*bytes);
+            uint64_t hi = 0;
+            uint64_t lo = 0;
+            if (x_coord < 64) {
+                hi = sprite >> x_coord;
+                lo = x_coord ? sprite << (64 - x_coord) : 0;
+            } else {
+                lo = sprite >> (x_coord - 64);
+            }
+            if (!display.hires)
+                lo = 0;
+
+            // apply changes, flag VF=1 if collision
+            Screen::Row& row = plane[y_coord+i];
+            if ((row[0] & hi) | (row[1] & lo))
+                var_regs[15] = 1;
+            row[0] ^= hi;
+            row[1] ^= lo;
+            if (hi | lo)
+                dirty_rows |= uint64_t(1) << (y_coord+i);
         }
-        
-        // apply changes, flag VF=1 if collision
-        collision_test = display[y_coord+i] | sprite_row;
-        display[y_coord+i] ^= sprite_row;
-        if (display[y_coord+i] != collision_test) {
-            var_regs[15] = 1;
+
+        // the next plane's sprite follows this one's
+        addr += rows * bytes;
+    }
+    CHIP8_STAT_DRAW(var_regs[15]);
+}
+
+// 00CN : scroll the selected planes down N rows
+void Chip8::scroll_down(uint8_t n) {
+    int height = display.height();
+    for (int p=0; p<Screen::plane_count; p++) {
+        if (!(plane_mask & (1 << p)))
+            continue;
+        Screen::Plane& plane = display.planes[p];
+        for (int r=height-1; r>=0; r--)
+            plane[r] = r >= n ? plane[r-n] : Screen::Row{};
+    }
+    dirty_rows = all_rows;
+}
+
+// 00DN : scroll the selected planes up N rows
+void Chip8::scroll_up(uint8_t n) {
+    int height = display.height();
+    for (int p=0; p<Screen::plane_count; p++) {
+        if (!(plane_mask & (1 << p)))
+            continue;
+        Screen::Plane& plane = display.planes[p];
+        for (int r=0; r<height; r++)
+            plane[r] = r + n < height ? plane[r+n] : Screen::Row{};
+    }
+    dirty_rows = all_rows;
+}
+
+// 00FB : scroll the selected planes right 4 pixels
+void Chip8::scroll_right() {
+    int height = display.height();
+    for (int p=0; p<Screen::plane_count; p++) {
+        if (!(plane_mask & (1 << p)))
+            continue;
+        for (int r=0; r<height; r++) {
+            Screen::Row& row = display.planes[p][r];
+            row[1] = display.hires ? (row[1] >> 4) | (row[0] << 60) : 0;
+            row[0] >>= 4;
         }
     }
+    dirty_rows = all_rows;
+}
+
+// 00FC : scroll the selected planes left 4 pixels
+void Chip8::scroll_left() {
+    int height = display.height();
+    for (int p=0; p<Screen::plane_count; p++) {
+        if (!(plane_mask & (1 << p)))
+            continue;
+        for (int r=0; r<height; r++) {
+            Screen::Row& row = display.planes[p][r];
+            row[0] = (row[0] << 4) | (row[1] >> 60);
+            row[1] <<= 4;
+        }
+    }
+    dirty_rows = all_rows;
+}
+
+// 00FD : exit - there is nothing to return to, so spin on the 00FD
+void Chip8::exit_program() {
+    program_counter -= 2;
+}
+
+// 00FE / 00FF : lores / hires - both planes are cleared on a switch
+void Chip8::set_hires(bool set) {
+    display = {};
+    display.hires = set;
+    dirty_rows = all_rows;
+}
+
+// FN01 : select the planes drawn, cleared & scrolled
+void Chip8::select_planes(uint8_t n) {
+    plane_mask = n & 3;
 }
 
 //////////////////////////////////////////////////
@@ -175,30 +464,30 @@ void Chip8::jump(uint16_t n) {
 }
 
 void Chip8::jump_offset(uint16_t n) {
-    int x = 0;
-    if (jump_offset_vx) {
-        x = (n & 0xF00) >> 8;
-    }
-    program_counter = n + var_regs[x];
+    with_quirks(get_quirks(), [&]<typename Q>() { jump_offset<Q>(n); });
 }
 
 int Chip8::subroutine_call(uint16_t n) {
-    if (stack.size() > 15) {
+    if (stack_pointer > 15) {
         return 1;   // stack overflow
     }
 
-    stack.push(program_counter);
+    stack[stack_pointer++] = program_counter;
+    CHIP8_STAT_STACK(stack_pointer);
+    if (call_watcher)
+        call_watcher->on_call(program_counter - 2, n);
     jump(n);
     return 0;
 }
 
 int Chip8::subroutine_return() {
-    if (stack.empty()) {
+    if (stack_pointer == 0) {
         return 1;
     }
 
-    jump(stack.top());
-    stack.pop();
+    jump(stack[--stack_pointer]);
+    if (call_watcher)
+        call_watcher->on_return(program_counter);
     return 0;
 }
 
@@ -273,22 +562,12 @@ void Chip8::bitwise_xor(uint8_t x, uint8_t y) {
 
 // 8XY6
 void Chip8::bitwise_shift_right(uint8_t x, uint8_t y) {
-    if (shift_use_vy)
-        var_regs[x] = var_regs[y];
-
-    uint8_t flag = var_regs[x] & 0x01;
-    var_regs[x] >>= 1;
-    var_regs[0xF] = flag;
+    with_quirks(get_quirks(), [&]<typename Q>() { bitwise_shift_right<Q>(x, y); });
 }
 
 // 8XYE
 void Chip8::bitwise_shift_left(uint8_t x, uint8_t y) {
-    if (shift_use_vy)
-        var_regs[x] = var_regs[y];
-
-    uint8_t flag = (var_regs[x] & 0x80) >> 7;
-    var_regs[x] <<= 1;
-    var_regs[0xF] = flag;
+    with_quirks(get_quirks(), [&]<typename Q>() { bitwise_shift_left<Q>(x, y); });
 }
 
 //////////////////////////////////////////////////
@@ -360,26 +639,19 @@ void Chip8::sprite_index(uint8_t x) {
     index_register = 0x050 + (var_regs[x] * 5);
 }
 
+// FX30 : Set index register to the 8x10 sprite for the low digit of Vx
+void Chip8::big_sprite_index(uint8_t x) {
+    index_register = big_font_addr + (var_regs[x] & 0xF) * 10;
+}
+
 // FX55 : register dump V0-Vx into memory, starting at location I
 void Chip8::reg_dump(uint8_t x) {
-    for (int i=0; i<=x; i++) {
-        memory[index_register+i] = var_regs[i];
-    }
-
-    if (store_load_i_inc) {
-        index_register += x + 1;
-    }
+    with_quirks(get_quirks(), [&]<typename Q>() { reg_dump<Q>(x); });
 }
 
 // FX65 : register load V0-Vx from memory, starting at location I
 void Chip8::reg_load(uint8_t x) {
-    for (int i=0; i<=x; i++) {
-        var_regs[i] = memory[index_register+i];
-    }
-
-    if (store_load_i_inc) {
-        index_register += x + 1;
-    }
+    with_quirks(get_quirks(), [&]<typename Q>() { reg_load<Q>(x); });
 }
 
 //////////////////////////////////////////////////
@@ -388,7 +660,12 @@ void Chip8::reg_load(uint8_t x) {
 
 // CXNN : Random
 void Chip8::gen_rand(uint8_t x, uint8_t n) {
-    var_regs[x] = rand() & n;
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+
+    // top byte of the xorshift64* output is the best mixed
+    var_regs[x] = uint8_t((rng_state * 0x2545F4914F6CDD1D) >> 56) & n;
 }
 
 //////////////////////////////////////////////////
@@ -414,6 +691,46 @@ uint8_t Chip8::get_var_reg(uint8_t x) {
     return var_regs[x];
 }
 
+uint16_t Chip8::get_index() {
+    return index_register;
+}
+
+uint16_t Chip8::get_pc() {
+    return program_counter;
+}
+
+uint8_t Chip8::get_stack_depth() {
+    return stack_pointer;
+}
+
+uint8_t Chip8::get_delay_timer() {
+    return delay_timer;
+}
+
+uint8_t Chip8::get_sound_timer() {
+    return sound_timer;
+}
+
+void Chip8::watch_memory(MemoryWatcher* w) {
+    watcher = w;
+}
+
+// a write running past 0xFFF carries on from 0x000, so it's reported as two
+void Chip8::notify_write(uint16_t addr, uint16_t len) {
+    if (!watcher)
+        return;
+
+    addr &= 0xFFF;
+    uint16_t head = std::min<int>(len, 0x1000 - addr);
+    watcher->on_write(addr, head);
+    if (len > head)
+        watcher->on_write(0, len - head);
+}
+
+void Chip8::watch_calls(CallWatcher* w) {
+    call_watcher = w;
+}
+
 //////////////////////////////////////////////////
 //                    Timer                     //
 //////////////////////////////////////////////////
@@ -441,9 +758,11 @@ void Chip8::set_sound(uint8_t x) {
 //                    BCD                       //
 //////////////////////////////////////////////////
 
-// FX33 : Binary-coded decimal conversion
+// FX33 : Binary-coded decimal conversion - addresses wrap to 12 bits
 void Chip8::bcd(uint8_t x) {
-    memory[index_register]   = var_regs[x] / 100;
-    memory[index_register+1] = (var_regs[x] % 100) / 10;
-    memory[index_register+2] = var_regs[x] % 10;
+    memory[index_register & 0xFFF]     = var_regs[x] / 100;
+    memory[(index_register+1) & 0xFFF] = (var_regs[x] % 100) / 10;
+    memory[(index_register+2) & 0xFFF] = var_regs[x] % 10;
+
+    notify_write(index_register, 3);
 }
\ No newline at end of file
@@ -0,0 +1,50 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <charconv>
+
+#include "cli.hh"
+
+bool parse_number(std::string_view text, uint64_t& value) {
+    int base = 10;
+    if (text.starts_with("0x") || text.starts_with("0X")) {
+        text.remove_prefix(2);
+        base = 16;
+    }
+    if (text.empty())
+        return false;
+
+    auto [end, err] = std::from_chars(text.data(), text.data() + text.size(), value, base);
+    return err == std::errc{} && end == text.data() + text.size();
+}
+
+bool parse_count(std::string_view text, uint64_t& count) {
+    if (text.starts_with("0x") || text.starts_with("0X"))
+        return false;
+    return parse_number(text, count) && count > 0;
+}
@@ -0,0 +1,520 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <algorithm>
+
+#include "dispatch.hh"
+#include "log.hh"
+#include "stats.hh"
+
+Dispatcher::Dispatcher(Chip8& chip8, Frontend& io) : chip8(chip8), io(io) {
+    quirks = 0xFF;
+    sync_quirks();
+    chip8.watch_memory(this);
+}
+
+Dispatcher::~Dispatcher() {
+    chip8.watch_memory(nullptr);
+}
+
+uint64_t Dispatcher::run(uint64_t n) {
+    sync_quirks();
+
+    uint64_t executed = 0;
+    while (executed < n && !chip8.end_of_mem())
+        executed += run_block(n - executed);
+    return executed;
+}
+
+uint64_t Dispatcher::run_block(uint64_t left) {
+    uint16_t start = chip8.program_counter;
+    int32_t index = block_at[start];
+    const Block& block = (index >= 0) ? blocks[index] : translate(start);
+    const Op* op = &ops[block.first_op];
+
+#ifdef CHIP8_STATS
+    // counted up front - the last Op may kill the block
+    StatCounters& counters = stat_counters();
+    for (uint64_t i=0; i<std::min<uint64_t>(block.len, left); i++)
+        stat_add(counters.ops[op[i].stat], 1);
+#endif
+
+    if (block.len <= left) {
+        const Op* last = op + block.len - 1;
+        for (; op != last; op++)
+            op->fn(*this, *op);
+
+        // the last Op may jump, skip or write memory & kill this block,
+        // so nothing from the block is touched after it runs
+        chip8.program_counter = block.end;
+        last->fn(*this, *last);
+        return block.len;
+    }
+
+    // out of budget mid-block - everything before the last Op is
+    // straight-line, so stopping early just means fixing up the pc
+    for (uint64_t i=0; i<left; i++)
+        op[i].fn(*this, op[i]);
+    chip8.program_counter = start + 2 * left;
+    return left;
+}
+
+void Dispatcher::on_write(uint16_t addr, uint16_t len) {
+    int first = addr;
+    int last  = std::min(int(addr) + int(len) - 1, 0xFFF);
+
+    bool hit = false;
+    for (int a=first; a<=last; a++)
+        hit |= code_bytes[a];
+    if (!hit)
+        return;
+
+    // kill every live block overlapping the write, then rebuild the coverage
+    code_bytes.reset();
+    for (int32_t i=0; i<int32_t(blocks.size()); i++) {
+        const Block& block = blocks[i];
+        if (block_at[block.start] != i)
+            continue;
+
+        if (block.start <= last && block.end > first) {
+            block_at[block.start] = -1;
+        }
+        else {
+            for (int a=block.start; a<block.end && a<=0xFFF; a++)
+                code_bytes[a] = true;
+        }
+    }
+}
+
+bool Dispatcher::sync_quirks() {
+    uint8_t bits = chip8.get_quirks();
+    if (bits == quirks)
+        return false;
+
+    quirks = bits;
+    decoder = with_quirks(bits, []<typename Q>() { return &decode<Q>; });
+    invalidate_all();
+    return true;
+}
+
+void Dispatcher::invalidate_all() {
+    ops.clear();
+    blocks.clear();
+    std::fill(block_at.begin(), block_at.end(), -1);
+    code_bytes.reset();
+}
+
+const Block& Dispatcher::translate(uint16_t start) {
+    // bound the storage, dead blocks pile up under self-modifying code
+    if (ops.size() > 0x10000)
+        invalidate_all();
+
+    Block block{start, start, uint32_t(ops.size()), 0};
+    uint16_t inst;
+    do {
+        uint16_t addr = block.end;
+        inst = (chip8.memory[addr] << 8) | chip8.memory[(addr + 1) & 0xFFF];
+        ops.push_back(decoder(inst));
+        block.len++;
+        block.end += 2;
+    } while (!ends_block(inst) && block.end <= 0xFFF);
+
+    for (int a=block.start; a<block.end && a<=0xFFF; a++)
+        code_bytes[a] = true;
+
+    block_at[start] = int32_t(blocks.size());
+    blocks.push_back(block);
+    return blocks.back();
+}
+
+//////////////////////////////////////////////////
+//                    Decode                    //
+//////////////////////////////////////////////////
+
+template <typename Q>
+Op Dispatcher::decode(uint16_t inst) {
+    Op op{op_nop, uint8_t((inst & 0x0F00) >> 8), uint8_t((inst & 0x00F0) >> 4),
+          uint8_t(inst & 0x000F), uint16_t(inst & 0x0FFF), stat_slot(inst)};
+    uint8_t nn = inst & 0x00FF;
+
+    switch ((inst & 0xF000) >> 12) {
+    case 0x0:
+        switch (op.nnn) {
+        case 0x0E0:    op.fn = op_cls;                    break;
+        case 0x0EE:    op.fn = op_ret;                    break;
+        case 0x0FB:    op.fn = op_scroll_right;           break;
+        case 0x0FC:    op.fn = op_scroll_left;            break;
+        case 0x0FD:    op.fn = op_exit;                   break;
+        case 0x0FE:    op.fn = op_lores;                  break;
+        case 0x0FF:    op.fn = op_hires;                  break;
+        default:
+            if ((op.nnn & 0xFF0) == 0x0C0)
+                op.fn = op_scroll_down;
+            else if ((op.nnn & 0xFF0) == 0x0D0)
+                op.fn = op_scroll_up;
+            break;
+        }
+        break;
+    case 0x1:    op.fn = op_jump;                         break;
+    case 0x2:    op.fn = op_call;                         break;
+    case 0x3:    op.fn = op_se_const;     op.nnn = nn;    break;
+    case 0x4:    op.fn = op_sne_const;    op.nnn = nn;    break;
+    case 0x5:    op.fn = op_se;                           break;
+    case 0x6:    op.fn = op_ld_const;     op.nnn = nn;    break;
+    case 0x7:    op.fn = op_add_const;    op.nnn = nn;    break;
+    case 0x8:
+        switch (op.n) {
+        case 0x0:    op.fn = op_ld;                       break;
+        case 0x1:    op.fn = op_or;                       break;
+        case 0x2:    op.fn = op_and;                      break;
+        case 0x3:    op.fn = op_xor;                      break;
+        case 0x4:    op.fn = op_add;                      break;
+        case 0x5:    op.fn = op_sub;                      break;
+        case 0x6:    op.fn = op_shr<Q>;                   break;
+        case 0x7:    op.fn = op_subn;                     break;
+        case 0xE:    op.fn = op_shl<Q>;                   break;
+        }
+        break;
+    case 0x9:    op.fn = op_sne;                          break;
+    case 0xA:    op.fn = op_ld_i;                         break;
+    case 0xB:    op.fn = op_jump_offset<Q>;               break;
+    case 0xC:    op.fn = op_rand;         op.nnn = nn;    break;
+    case 0xD:    op.fn = op_draw;                         break;
+    case 0xE:
+        switch (nn) {
+        case 0x9E:    op.fn = op_skp;                     break;
+        case 0xA1:    op.fn = op_sknp;                    break;
+        }
+        break;
+    case 0xF:
+        switch (nn) {
+        case 0x01:    op.fn = op_planes;                  break;
+        case 0x07:    op.fn = op_get_delay;               break;
+        case 0x0A:    op.fn = op_wait_key;                break;
+        case 0x15:    op.fn = op_set_delay;               break;
+        case 0x18:    op.fn = op_set_sound;               break;
+        case 0x1E:    op.fn = op_add_i;                   break;
+        case 0x29:    op.fn = op_font;                    break;
+        case 0x30:    op.fn = op_big_font;                break;
+        case 0x33:    op.fn = op_bcd;                     break;
+        case 0x55:    op.fn = op_dump<Q>;                 break;
+        case 0x65:    op.fn = op_load<Q>;                 break;
+        }
+        break;
+    }
+    return op;
+}
+
+bool Dispatcher::ends_block(uint16_t inst) {
+    switch ((inst & 0xF000) >> 12) {
+    case 0x0:    return inst == 0x00EE || inst == 0x00FD;
+    case 0x1:
+    case 0x2:
+    case 0x3:
+    case 0x4:
+    case 0x5:
+    case 0x9:
+    case 0xB:
+    case 0xE:    return true;
+    case 0xF:
+        switch (inst & 0x00FF) {
+        case 0x0A:
+        case 0x33:
+        case 0x55:    return true;
+        }
+        return false;
+    }
+    return false;
+}
+
+//////////////////////////////////////////////////
+//                   Handlers                   //
+//////////////////////////////////////////////////
+
+void Dispatcher::op_nop(Dispatcher&, const Op&) {}
+
+// 00E0
+void Dispatcher::op_cls(Dispatcher& d, const Op&) {
+    d.chip8.disp_clear();
+}
+
+// 00EE
+void Dispatcher::op_ret(Dispatcher& d, const Op&) {
+    d.chip8.subroutine_return();
+}
+
+// 00CN
+void Dispatcher::op_scroll_down(Dispatcher& d, const Op& op) {
+    d.chip8.scroll_down(op.n);
+}
+
+// 00DN
+void Dispatcher::op_scroll_up(Dispatcher& d, const Op& op) {
+    d.chip8.scroll_up(op.n);
+}
+
+// 00FB
+void Dispatcher::op_scroll_right(Dispatcher& d, const Op&) {
+    d.chip8.scroll_right();
+}
+
+// 00FC
+void Dispatcher::op_scroll_left(Dispatcher& d, const Op&) {
+    d.chip8.scroll_left();
+}
+
+// 00FD - always ends a block, it steps the program counter back onto itself
+void Dispatcher::op_exit(Dispatcher& d, const Op&) {
+    d.chip8.exit_program();
+}
+
+// 00FE
+void Dispatcher::op_lores(Dispatcher& d, const Op&) {
+    d.chip8.set_hires(false);
+}
+
+// 00FF
+void Dispatcher::op_hires(Dispatcher& d, const Op&) {
+    d.chip8.set_hires(true);
+}
+
+// 1NNN
+void Dispatcher::op_jump(Dispatcher& d, const Op& op) {
+    d.chip8.program_counter = op.nnn;
+}
+
+// 2NNN
+void Dispatcher::op_call(Dispatcher& d, const Op& op) {
+    d.chip8.subroutine_call(op.nnn);
+}
+
+// 3XNN
+void Dispatcher::op_se_const(Dispatcher& d, const Op& op) {
+    if (d.chip8.var_regs[op.x] == op.nnn)
+        d.chip8.program_counter += 2;
+}
+
+// 4XNN
+void Dispatcher::op_sne_const(Dispatcher& d, const Op& op) {
+    if (d.chip8.var_regs[op.x] != op.nnn)
+        d.chip8.program_counter += 2;
+}
+
+// 5XY0
+void Dispatcher::op_se(Dispatcher& d, const Op& op) {
+    if (d.chip8.var_regs[op.x] == d.chip8.var_regs[op.y])
+        d.chip8.program_counter += 2;
+}
+
+// 9XY0
+void Dispatcher::op_sne(Dispatcher& d, const Op& op) {
+    if (d.chip8.var_regs[op.x] != d.chip8.var_regs[op.y])
+        d.chip8.program_counter += 2;
+}
+
+// 6XNN
+void Dispatcher::op_ld_const(Dispatcher& d, const Op& op) {
+    d.chip8.var_regs[op.x] = op.nnn;
+}
+
+// 7XNN
+void Dispatcher::op_add_const(Dispatcher& d, const Op& op) {
+    d.chip8.var_regs[op.x] += op.nnn;
+}
+
+// 8XY0
+void Dispatcher::op_ld(Dispatcher& d, const Op& op) {
+    d.chip8.var_regs[op.x] = d.chip8.var_regs[op.y];
+}
+
+// 8XY1
+void Dispatcher::op_or(Dispatcher& d, const Op& op) {
+    d.chip8.var_regs[op.x] |= d.chip8.var_regs[op.y];
+}
+
+// 8XY2
+void Dispatcher::op_and(Dispatcher& d, const Op& op) {
+    d.chip8.var_regs[op.x] &= d.chip8.var_regs[op.y];
+}
+
+// 8XY3
+void Dispatcher::op_xor(Dispatcher& d, const Op& op) {
+    d.chip8.var_regs[op.x] ^= d.chip8.var_regs[op.y];
+}
+
+// 8XY4 - VF = carry
+void Dispatcher::op_add(Dispatcher& d, const Op& op) {
+    auto& v = d.chip8.var_regs;
+    unsigned sum = v[op.x] + v[op.y];
+    v[op.x] = sum;
+    v[0xF] = sum > 0xFF;
+}
+
+// 8XY5 - VF = no borrow
+void Dispatcher::op_sub(Dispatcher& d, const Op& op) {
+    auto& v = d.chip8.var_regs;
+    uint8_t vx = v[op.x];
+    uint8_t vy = v[op.y];
+    v[op.x] = vx - vy;
+    v[0xF] = vx >= vy;
+}
+
+// 8XY6
+template <typename Q>
+void Dispatcher::op_shr(Dispatcher& d, const Op& op) {
+    d.chip8.bitwise_shift_right<Q>(op.x, op.y);
+}
+
+// 8XY7 - VF = no borrow
+void Dispatcher::op_subn(Dispatcher& d, const Op& op) {
+    auto& v = d.chip8.var_regs;
+    uint8_t vx = v[op.x];
+    uint8_t vy = v[op.y];
+    v[op.x] = vy - vx;
+    v[0xF] = vy >= vx;
+}
+
+// 8XYE
+template <typename Q>
+void Dispatcher::op_shl(Dispatcher& d, const Op& op) {
+    d.chip8.bitwise_shift_left<Q>(op.x, op.y);
+}
+
+// ANNN
+void Dispatcher::op_ld_i(Dispatcher& d, const Op& op) {
+    d.chip8.index_register = op.nnn;
+}
+
+// BNNN
+template <typename Q>
+void Dispatcher::op_jump_offset(Dispatcher& d, const Op& op) {
+    d.chip8.jump_offset<Q>(op.nnn);
+}
+
+// CXNN
+void Dispatcher::op_rand(Dispatcher& d, const Op& op) {
+    d.chip8.gen_rand(op.x, op.nnn);
+}
+
+// DXYN
+void Dispatcher::op_draw(Dispatcher& d, const Op& op) {
+    d.chip8.draw(op.x, op.y, op.n);
+}
+
+// EX9E
+void Dispatcher::op_skp(Dispatcher& d, const Op& op) {
+    if (d.io.key_is_pressed(d.chip8.var_regs[op.x]))
+        d.chip8.program_counter += 2;
+}
+
+// EXA1
+void Dispatcher::op_sknp(Dispatcher& d, const Op& op) {
+    if (!d.io.key_is_pressed(d.chip8.var_regs[op.x]))
+        d.chip8.program_counter += 2;
+}
+
+// FN01
+void Dispatcher::op_planes(Dispatcher& d, const Op& op) {
+    d.chip8.select_planes(op.x);
+}
+
+// FX07
+void Dispatcher::op_get_delay(Dispatcher& d, const Op& op) {
+    d.chip8.var_regs[op.x] = d.chip8.delay_timer;
+}
+
+// FX0A - same block_state machine as instruction_cycle()
+void Dispatcher::op_wait_key(Dispatcher& d, const Op& op) {
+    Chip8& c = d.chip8;
+    int key = d.io.get_curr_key();
+    switch (c.block_state) {
+    case 0:
+        c.block_state = 1;
+        c.program_counter -= 2;
+        break;
+    case 1:
+        if (key >= 0) {
+            c.var_regs[op.x] = key;
+            c.block_state = 2;
+            CHIP8_LOG(Debug, "FX0A: key {} down, V{} set", key, op.x);
+        }
+        c.program_counter -= 2;
+        break;
+    case 2:
+        if (key == -1) {
+            c.block_state = 0;
+            CHIP8_LOG(Debug, "FX0A: key {} up, V{} done waiting", c.var_regs[op.x], op.x);
+        }
+        else {
+            c.program_counter -= 2;
+        }
+        break;
+    }
+}
+
+// FX15
+void Dispatcher::op_set_delay(Dispatcher& d, const Op& op) {
+    d.chip8.delay_timer = d.chip8.var_regs[op.x];
+}
+
+// FX18
+void Dispatcher::op_set_sound(Dispatcher& d, const Op& op) {
+    d.chip8.sound_timer = d.chip8.var_regs[op.x];
+}
+
+// FX1E
+void Dispatcher::op_add_i(Dispatcher& d, const Op& op) {
+    d.chip8.index_register += d.chip8.var_regs[op.x];
+}
+
+// FX29
+void Dispatcher::op_font(Dispatcher& d, const Op& op) {
+    d.chip8.index_register = 0x050 + (d.chip8.var_regs[op.x] * 5);
+}
+
+// FX30
+void Dispatcher::op_big_font(Dispatcher& d, const Op& op) {
+    d.chip8.big_sprite_index(op.x);
+}
+
+// FX33 - always ends a block, invalidation happens through on_write()
+void Dispatcher::op_bcd(Dispatcher& d, const Op& op) {
+    d.chip8.bcd(op.x);
+}
+
+// FX55 - always ends a block, invalidation happens through on_write()
+template <typename Q>
+void Dispatcher::op_dump(Dispatcher& d, const Op& op) {
+    d.chip8.reg_dump<Q>(op.x);
+}
+
+// FX65
+template <typename Q>
+void Dispatcher::op_load(Dispatcher& d, const Op& op) {
+    d.chip8.reg_load<Q>(op.x);
+}
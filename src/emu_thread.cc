@@ -0,0 +1,216 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <algorithm>
+
+#include "beeper.hh"
+#include "emu_thread.hh"
+#include "movie.hh"
+#include "scheduler.hh"
+
+// a press the display hasn't changed for in this many frames isn't timed
+constexpr uint64_t max_latency_frames = 10;
+
+EmuThread::EmuThread(Chip8& chip8, Frontend& input, std::string_view engine_name, size_t rewind_budget,
+                     MovieWriter* record, MovieReader* play, Beeper* beeper, InputQueue* queue)
+    : chip8(chip8), input(input), record(record), play(play), beeper(beeper), queue(queue),
+      unshown_input_ns(0), unshown_frame(0), shown_input_ns(0), speed(1), frame_count(0),
+      throttle_presents(false), present_pending(false), stop_requested(false), stopped(false),
+      hit_end_of_mem(false), rewinding(false) {
+    engine = make_engine(engine_name, chip8, *this);
+    if (!engine)
+        engine = make_engine("dispatch", chip8, *this);
+
+    if (rewind_budget > 0)
+        rewind = std::make_unique<Rewind>(rewind_budget);
+
+    // started last, everything it touches is set up by now
+    thread = std::thread(&EmuThread::loop, this);
+}
+
+EmuThread::~EmuThread() {
+    stop();
+}
+
+void EmuThread::loop() {
+    Scheduler scheduler(chip8, *engine, *this);
+    SaveState state;
+
+    while (!stop_requested.load(std::memory_order_relaxed)) {
+        int multiple = speed.load(std::memory_order_relaxed);
+        scheduler.set_speed(multiple);
+        throttle_presents = (multiple != 1);
+
+        if (rewind && rewinding.load(std::memory_order_relaxed)) {
+            if (rewind->step_back(state)) {
+                chip8.load(state);
+                draw_pixels(chip8.get_display(), chip8.take_dirty_rows());
+            }
+            if (beeper)
+                beeper->update(scheduler.get_frame_count(), false);
+            if (queue)
+                queue->skip(input_clock_ns());
+            scheduler.wait_frame();
+            continue;
+        }
+
+        latch_keys(scheduler.get_frame_count(), scheduler.get_budget());
+        scheduler.run_frame(steps, keypad);
+        frame_count.store(scheduler.get_frame_count(), std::memory_order_relaxed);
+        if (present_pending && (!throttle_presents || std::chrono::steady_clock::now() >= next_present))
+            publish(chip8.get_display());
+        if (unshown_input_ns && scheduler.get_frame_count() - unshown_frame > max_latency_frames)
+            unshown_input_ns = 0;
+        if (beeper)
+            beeper->update(scheduler.get_frame_count(), !throttle_presents && chip8.get_sound_timer() > 0);
+        if (chip8.end_of_mem()) {
+            hit_end_of_mem.store(true);
+            break;
+        }
+
+        if (rewind) {
+            chip8.save(state);
+            rewind->push(state);
+        }
+        scheduler.wait_frame();
+    }
+    if (beeper)
+        beeper->update(scheduler.get_frame_count(), false);
+    stopped.store(true);
+}
+
+// keys for the coming frame of budget instructions - from the movie while it
+// lasts, then live: as steps within the frame from the queue, or latched
+void EmuThread::latch_keys(uint64_t frame, uint64_t budget) {
+    steps.clear();
+
+    uint16_t keys = 0;
+    if (play && play->next(keys)) {
+        // live input waits for the movie to end
+        if (queue)
+            queue->skip(input_clock_ns());
+    }
+    else if (queue) {
+        play = nullptr;
+        uint16_t held = queue->get_keys();
+        queue->take_frame(input_clock_ns(), budget, record != nullptr, steps);
+        for (const KeyStep& step : steps) {
+            if ((step.keys & ~held) && !unshown_input_ns) {
+                unshown_input_ns = step.time_ns;
+                unshown_frame = frame;
+            }
+            held = step.keys;
+        }
+        keys = queue->get_keys();
+
+        // a movie holds one keypad a frame - the steps are all at the start anyway
+        if (record)
+            steps.clear();
+    }
+    else {
+        play = nullptr;
+        for (int k=0; k<16; k++)
+            keys |= uint16_t(input.key_is_pressed(k)) << k;
+    }
+
+    if (record)
+        record->record(keys);
+    if (steps.empty())
+        keypad.set_keys(keys);
+}
+
+void EmuThread::stop() {
+    stop_requested.store(true);
+    if (thread.joinable())
+        thread.join();
+}
+
+bool EmuThread::is_running() {
+    return !stopped.load();
+}
+
+bool EmuThread::end_of_mem() {
+    return hit_end_of_mem.load();
+}
+
+void EmuThread::set_rewinding(bool set) {
+    rewinding.store(set, std::memory_order_relaxed);
+}
+
+void EmuThread::set_speed(int multiple) {
+    speed.store(std::max(multiple, 0), std::memory_order_relaxed);
+}
+
+uint64_t EmuThread::get_frame_count() {
+    return frame_count.load(std::memory_order_relaxed);
+}
+
+bool EmuThread::take_frame(Screen& out, uint64_t& input_ns) {
+    if (!frames.update())
+        return false;
+    out = frames.read_slot();
+    input_ns = shown_input_ns.exchange(0);
+    return true;
+}
+
+bool EmuThread::key_is_pressed(uint8_t key) {
+    return keypad.key_is_pressed(key);
+}
+
+int EmuThread::get_curr_key() {
+    return keypad.get_curr_key();
+}
+
+// the consumer works out its own dirty rows by comparing against what it last
+// showed, so frames it never picked up don't lose any changes
+void EmuThread::draw_pixels(const Screen& display, uint64_t) {
+    // off real time, at most one present per 60 Hz of host time - a skipped
+    // frame goes out at the end of a later one
+    if (throttle_presents) {
+        auto now = std::chrono::steady_clock::now();
+        if (now < next_present) {
+            present_pending = true;
+            return;
+        }
+        next_present = now + std::chrono::nanoseconds{1000000000 / 60};
+    }
+    publish(display);
+}
+
+void EmuThread::publish(const Screen& display) {
+    present_pending = false;
+    frames.write_slot() = display;
+    frames.publish();
+
+    // if the UI thread hasn't picked up the last one, the older press stands
+    if (unshown_input_ns) {
+        uint64_t none = 0;
+        shown_input_ns.compare_exchange_strong(none, unshown_input_ns);
+        unshown_input_ns = 0;
+    }
+}
@@ -0,0 +1,55 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include "dispatch.hh"
+#include "engine.hh"
+#include "interpreter.hh"
+
+#ifdef CHIP8_JIT
+#include "jit.hh"
+#endif
+
+std::unique_ptr<Engine> make_engine(std::string_view name, Chip8& chip8, Frontend& io) {
+    if (name == "switch")
+        return std::make_unique<SwitchEngine>(chip8, io);
+    if (name == "dispatch")
+        return std::make_unique<Dispatcher>(chip8, io);
+#ifdef CHIP8_JIT
+    if (name == "jit")
+        return std::make_unique<Jit>(chip8, io);
+#endif
+    return nullptr;
+}
+
+bool has_engine(std::string_view name) {
+#ifdef CHIP8_JIT
+    if (name == "jit")
+        return true;
+#endif
+    return name == "switch" || name == "dispatch";
+}
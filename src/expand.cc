@@ -0,0 +1,187 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <charconv>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define EXPAND_X86 1
+#endif
+
+#include "expand.hh"
+
+// Every kernel is the same select: pixel = bg ^ ((fg ^ bg) & mask), where
+// mask is all ones for a set bit. The vector kernels build the masks for a
+// whole byte of pixels at once by broadcasting the byte & comparing it
+// against one bit per lane.
+
+namespace {
+
+using Kernel = void (*)(const uint64_t*, size_t, uint32_t*, Palette);
+
+void expand_scalar(const uint64_t* words, size_t count, uint32_t* out, Palette p) {
+    uint32_t diff = p.fg ^ p.bg;
+    for (size_t w=0; w<count; w++) {
+        uint64_t row = words[w];
+        for (int bit=63; bit>=0; bit--)
+            *(out++) = p.bg ^ (diff & (0u - uint32_t((row >> bit) & 1)));
+    }
+}
+
+#ifdef EXPAND_X86
+
+__attribute__((target("sse2")))
+void expand_sse2(const uint64_t* words, size_t count, uint32_t* out, Palette p) {
+    const __m128i hi = _mm_setr_epi32(0x80, 0x40, 0x20, 0x10);
+    const __m128i lo = _mm_setr_epi32(0x08, 0x04, 0x02, 0x01);
+    const __m128i bg = _mm_set1_epi32(p.bg);
+    const __m128i diff = _mm_set1_epi32(p.fg ^ p.bg);
+
+    for (size_t w=0; w<count; w++) {
+        uint64_t row = words[w];
+        for (int byte=7; byte>=0; byte--) {
+            __m128i bits = _mm_set1_epi32((row >> (byte * 8)) & 0xFF);
+            __m128i mask_hi = _mm_cmpeq_epi32(_mm_and_si128(bits, hi), hi);
+            __m128i mask_lo = _mm_cmpeq_epi32(_mm_and_si128(bits, lo), lo);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out),     _mm_xor_si128(bg, _mm_and_si128(diff, mask_hi)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_xor_si128(bg, _mm_and_si128(diff, mask_lo)));
+            out += 8;
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+void expand_avx2(const uint64_t* words, size_t count, uint32_t* out, Palette p) {
+    const __m256i lanes = _mm256_setr_epi32(0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+    const __m256i bg = _mm256_set1_epi32(p.bg);
+    const __m256i diff = _mm256_set1_epi32(p.fg ^ p.bg);
+
+    for (size_t w=0; w<count; w++) {
+        uint64_t row = words[w];
+        for (int byte=7; byte>=0; byte--) {
+            __m256i bits = _mm256_set1_epi32((row >> (byte * 8)) & 0xFF);
+            __m256i mask = _mm256_cmpeq_epi32(_mm256_and_si256(bits, lanes), lanes);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_xor_si256(bg, _mm256_and_si256(diff, mask)));
+            out += 8;
+        }
+    }
+}
+
+#endif
+
+Kernel kernel_for(ExpandKernel k) {
+    switch (k) {
+#ifdef EXPAND_X86
+    case ExpandKernel::SSE2:    return expand_sse2;
+    case ExpandKernel::AVX2:    return expand_avx2;
+#endif
+    default:                    return expand_scalar;
+    }
+}
+
+}
+
+void expand_rows(const uint64_t* words, size_t width, size_t rows, uint32_t* out, Palette p) {
+    // picked once, the first time anything is expanded
+    static const Kernel best_kernel = kernel_for(expand_kernel_best());
+    best_kernel(words, rows * (width / 64), out, p);
+}
+
+void expand_rows_with(ExpandKernel k, const uint64_t* words, size_t width, size_t rows, uint32_t* out, Palette p) {
+    kernel_for(k)(words, rows * (width / 64), out, p);
+}
+
+void expand_planes(const uint64_t* plane0, const uint64_t* plane1, size_t width, size_t rows,
+                   uint32_t* out, Palette p) {
+    size_t row_words = width / 64;
+    const uint32_t colors[4] = {p.bg, p.fg, p.plane2, p.both};
+
+    for (size_t r=0; r<rows; r++, plane0 += row_words, plane1 += row_words, out += width) {
+        uint64_t any = 0;
+        for (size_t w=0; w<row_words; w++)
+            any |= plane1[w];
+
+        // nothing on plane 2 - the plain 1bpp kernels do the row
+        if (!any) {
+            expand_rows(plane0, width, 1, out, p);
+            continue;
+        }
+
+        for (size_t w=0; w<row_words; w++)
+            for (int b=0; b<64; b++) {
+                int index = ((plane0[w] >> (63 - b)) & 1) | (((plane1[w] >> (63 - b)) & 1) << 1);
+                out[w*64 + b] = colors[index];
+            }
+    }
+}
+
+bool expand_kernel_supported(ExpandKernel k) {
+#ifdef EXPAND_X86
+    __builtin_cpu_init();
+#endif
+    switch (k) {
+    case ExpandKernel::Scalar:    return true;
+#ifdef EXPAND_X86
+    case ExpandKernel::SSE2:      return __builtin_cpu_supports("sse2");
+    case ExpandKernel::AVX2:      return __builtin_cpu_supports("avx2");
+#endif
+    default:                      return false;
+    }
+}
+
+ExpandKernel expand_kernel_best() {
+    if (expand_kernel_supported(ExpandKernel::AVX2))
+        return ExpandKernel::AVX2;
+    if (expand_kernel_supported(ExpandKernel::SSE2))
+        return ExpandKernel::SSE2;
+    return ExpandKernel::Scalar;
+}
+
+char const* expand_kernel_name(ExpandKernel k) {
+    switch (k) {
+    case ExpandKernel::Scalar:    return "scalar";
+    case ExpandKernel::SSE2:      return "sse2";
+    case ExpandKernel::AVX2:      return "avx2";
+    }
+    return "?";
+}
+
+bool parse_color(std::string_view text, uint32_t& color) {
+    if (!text.empty() && text[0] == '#')
+        text.remove_prefix(1);
+    if (text.size() != 6)
+        return false;
+
+    uint32_t rgb;
+    auto [end, err] = std::from_chars(text.data(), text.data() + text.size(), rgb, 16);
+    if (err != std::errc{} || end != text.data() + text.size())
+        return false;
+
+    color = (rgb << 8) | 0xFF;
+    return true;
+}
@@ -0,0 +1,66 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include "headless.hh"
+
+HeadlessFrontend::HeadlessFrontend() {
+    keys = 0;
+    last_key_down = -1;
+    draw_count = 0;
+}
+
+void HeadlessFrontend::set_keys(uint16_t new_keys) {
+    // newly pressed keys become the "last key down", same as a key down event
+    uint16_t pressed = new_keys & ~keys;
+    for (int i=15; i>=0; i--) {
+        if (pressed & (1 << i)) {
+            last_key_down = i;
+            break;
+        }
+    }
+    if (last_key_down >= 0 && !(new_keys & (1 << last_key_down)))
+        last_key_down = -1;
+
+    keys = new_keys;
+}
+
+uint64_t HeadlessFrontend::get_draw_count() {
+    return draw_count;
+}
+
+bool HeadlessFrontend::key_is_pressed(uint8_t key) {
+    return keys & (1 << (key & 0xF));
+}
+
+int HeadlessFrontend::get_curr_key() {
+    return last_key_down;
+}
+
+void HeadlessFrontend::draw_pixels(const Screen&, uint64_t) {
+    draw_count++;
+}
@@ -0,0 +1,364 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+#include "aot.hh"
+#include "chip8.hh"
+#include "cli.hh"
+#include "engine.hh"
+#include "expand.hh"
+#include "headless.hh"
+#include "movie.hh"
+#include "profiler.hh"
+#include "romdb.hh"
+#include "savestate.hh"
+#include "scheduler.hh"
+#include "stats.hh"
+
+// Runs a ROM with no window for a fixed number of instructions or frames, as
+// fast as the host allows, then reports throughput & final machine state.
+// Built with CHIP8_AOT_RUNNER (chip8_add_aot_runner), it also carries one ROM
+// recompiled ahead of time & runs it on AotEngine by default.
+
+#ifdef CHIP8_AOT_RUNNER
+static char const* const default_engine = "aot";
+#else
+static char const* const default_engine = "dispatch";
+#endif
+
+static bool dump_display(char const* path, Chip8& chip8, Palette palette) {
+    const Screen& display = chip8.get_display();
+    std::array<uint32_t, Screen::max_width * Screen::max_height> pixels;
+    expand_planes(display.planes[0][0].data(), display.planes[1][0].data(), Screen::max_width, display.height(),
+                  pixels.data(), palette);
+
+    std::FILE* out = std::fopen(path, "wb");
+    if (!out)
+        return false;
+
+    // the image is the current resolution, lores is the left half of each row
+    std::fprintf(out, "P6\n%d %d\n255\n", display.width(), display.height());
+    for (int y=0; y<display.height(); y++) {
+        for (int x=0; x<display.width(); x++) {
+            uint32_t pixel = pixels[y * Screen::max_width + x];
+            uint8_t rgb[3] = {uint8_t(pixel >> 24), uint8_t(pixel >> 16), uint8_t(pixel >> 8)};
+            std::fwrite(rgb, 1, 3, out);
+        }
+    }
+    return std::fclose(out) == 0;
+}
+
+static void usage(char const* name) {
+    std::cerr << "usage: " << name << " <rom.ch8> [--insts N | --frames N] [--ips N] [--engine E]\n"
+              << "  --insts N    run N instructions (default 10000000)\n"
+              << "  --frames N   run N 60 Hz frames (ips / 60 instructions + a timer tick each)\n"
+              << "  --ips N      instructions per second the ROM expects (default 700)\n"
+              << "  --engine E   switch | dispatch | jit"
+#ifdef CHIP8_AOT_RUNNER
+              << " | aot - the recompiled " << aot_program.name
+#endif
+              << " (default " << default_engine << ")\n"
+              << "  --quirks P   vip | chip48 | schip (default none of the quirks)\n"
+              << "  --seed N     seed for CXNN random numbers (default 0)\n"
+              << "  --dump F     write the final display to F as a binary PPM\n"
+              << "  --fg RRGGBB  --bg RRGGBB   colours for --dump\n"
+              << "  --load-state F   start from the save state in F instead of power-on\n"
+              << "  --save-state F   write a save state to F when done\n"
+              << "  --play F     replay the input movie in F from power-on, as fast as possible\n"
+              << "               (its seed & configuration replace --seed & --ips)\n"
+              << "  --profile F  profile the guest program exactly (instead of --engine), write a\n"
+              << "               flat profile, call graph & hotspots to F\n"
+              << "  --folded F   with the profiler, write folded stacks for flame graph tools to F\n"
+              << "  --stats F    write execution statistics to F as JSON on exit & on SIGUSR1\n"
+              << "               (needs a -DCHIP8_STATS=ON build)\n"
+              << "  --rom-info   print the ROM's hash, its database entry if any, & the entry line\n"
+              << "               for it with the --ips & --quirks given, then exit\n"
+              << "ips & quirks not given come from the ROM database when the ROM is in it\n";
+}
+
+int main(int argc, char ** argv) {
+    char const* rom_arg = nullptr;
+    uint64_t insts = 10000000;
+    uint64_t frames = 0;
+    int ips = 0;
+    uint64_t seed = 0;
+    char const* quirks_name = nullptr;
+    char const* engine_name = default_engine;
+    char const* dump_path = nullptr;
+    char const* load_path = nullptr;
+    char const* save_path = nullptr;
+    char const* play_path = nullptr;
+    char const* stats_path = nullptr;
+    char const* profile_path = nullptr;
+    char const* folded_path = nullptr;
+    bool rom_info = false;
+    Palette palette{};
+
+    for (int i=1; i<argc; i++) {
+        uint64_t number = 0;
+        if (!std::strcmp(argv[i], "--insts") && i+1 < argc && parse_count(argv[i+1], insts)) {
+            i++;
+        }
+        else if (!std::strcmp(argv[i], "--frames") && i+1 < argc && parse_count(argv[i+1], frames)) {
+            i++;
+        }
+        else if (!std::strcmp(argv[i], "--ips") && i+1 < argc && parse_count(argv[i+1], number)
+                 && number <= INT_MAX) {
+            ips = int(number);
+            i++;
+        }
+        else if (!std::strcmp(argv[i], "--quirks") && i+1 < argc) {
+            quirks_name = argv[++i];
+        }
+        else if (!std::strcmp(argv[i], "--seed") && i+1 < argc && parse_number(argv[i+1], seed)) {
+            i++;
+        }
+        else if (!std::strcmp(argv[i], "--engine") && i+1 < argc) {
+            engine_name = argv[++i];
+        }
+        else if (!std::strcmp(argv[i], "--load-state") && i+1 < argc) {
+            load_path = argv[++i];
+        }
+        else if (!std::strcmp(argv[i], "--save-state") && i+1 < argc) {
+            save_path = argv[++i];
+        }
+        else if (!std::strcmp(argv[i], "--play") && i+1 < argc) {
+            play_path = argv[++i];
+        }
+        else if (!std::strcmp(argv[i], "--profile") && i+1 < argc) {
+            profile_path = argv[++i];
+        }
+        else if (!std::strcmp(argv[i], "--folded") && i+1 < argc) {
+            folded_path = argv[++i];
+        }
+        else if (!std::strcmp(argv[i], "--stats") && i+1 < argc) {
+            stats_path = argv[++i];
+        }
+        else if (!std::strcmp(argv[i], "--rom-info")) {
+            rom_info = true;
+        }
+        else if (!std::strcmp(argv[i], "--dump") && i+1 < argc) {
+            dump_path = argv[++i];
+        }
+        else if (!std::strcmp(argv[i], "--fg") && i+1 < argc && parse_color(argv[i+1], palette.fg)) {
+            i++;
+        }
+        else if (!std::strcmp(argv[i], "--bg") && i+1 < argc && parse_color(argv[i+1], palette.bg)) {
+            i++;
+        }
+        else if (argv[i][0] != '-' && !rom_arg) {
+            rom_arg = argv[i];
+        }
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!rom_arg) {
+        usage(argv[0]);
+        return 1;
+    }
+
+#ifndef CHIP8_STATS
+    if (stats_path)
+        std::cerr << "warning: built without CHIP8_STATS, --stats does nothing\n";
+#endif
+    stats_install(stats_path);
+
+    std::filesystem::path rom{rom_arg};
+    if (!std::filesystem::exists(rom)) {
+        std::cerr << "error: " << rom_arg << " does not exist\n";
+        return 1;
+    }
+
+    std::vector<uint8_t> rom_bytes = read_rom_file(rom);
+    uint64_t hash = rom_hash(rom_bytes);
+    const RomInfo* known = rom_lookup(hash);
+
+    QuirkProfile profile;
+    if (quirks_name && !parse_quirk_profile(quirks_name, profile)) {
+        std::cerr << "error: unknown quirks " << quirks_name << "\n";
+        return 1;
+    }
+
+    if (rom_info) {
+        std::printf("hash          0x%016llX\n", (unsigned long long)hash);
+        if (known)
+            std::printf("known         %s  (ips %d, quirks %d)\n", known->title, known->ips, known->quirks);
+        else
+            std::printf("known         no\n");
+        std::printf("entry         {0x%016llX, %d, %d, \"%s\"},\n", (unsigned long long)hash, std::max(ips, 0),
+                    quirks_name ? quirk_profile_bits(profile) : -1, rom.stem().string().c_str());
+        return 0;
+    }
+
+    Chip8 chip8(rom_bytes);
+    chip8.seed_rand(seed);
+    HeadlessFrontend io{};
+
+    std::unique_ptr<Engine> engine;
+    Profiler* profiler = nullptr;
+    if (profile_path || folded_path) {
+        auto owned = std::make_unique<Profiler>(chip8, io);
+        profiler = owned.get();
+        engine = std::move(owned);
+    }
+#ifdef CHIP8_AOT_RUNNER
+    else if (!std::strcmp(engine_name, "aot")) {
+        engine = std::make_unique<AotEngine>(chip8, io, aot_program);
+    }
+#endif
+    else {
+        engine = make_engine(engine_name, chip8, io);
+    }
+    if (!engine) {
+        std::cerr << "error: unknown engine " << engine_name << "\n";
+        return 1;
+    }
+
+    if (load_path) {
+        SaveState state;
+        if (read_state_file(load_path, state) || chip8.load(state)) {
+            std::cerr << "error: " << load_path << " is not a valid save state\n";
+            return 1;
+        }
+    }
+
+    // flags first, then the database - a save state brings its own configuration
+    if (load_path)
+        known = nullptr;
+    if (ips > 0)
+        chip8.config_timing(ips);
+    else if (known && known->ips > 0)
+        chip8.config_timing(known->ips);
+
+    if (quirks_name)
+        chip8.config_quirks(profile);
+    else if (known && known->quirks >= 0)
+        chip8.config_quirk_bits(known->quirks);
+#ifdef CHIP8_AOT_RUNNER
+    else if (!load_path)
+        chip8.config_quirk_bits(aot_program.quirks);    // what the blocks were compiled for
+#endif
+
+    MovieReader movie;
+    if (play_path) {
+        if (load_path) {
+            std::cerr << "error: a movie plays from power-on, it can't start from a save state\n";
+            return 1;
+        }
+        if (movie.open(play_path)) {
+            std::cerr << "error: " << play_path << " is not a valid movie\n";
+            return 1;
+        }
+        if (start_movie(chip8, movie.get_header())) {
+            std::cerr << "error: " << play_path << " was recorded with a different ROM\n";
+            return 1;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // frames are paced by instruction count only, never by the host clock
+    uint64_t executed = 0;
+    uint64_t played = 0;
+    if (play_path) {
+        // same order as EmuThread - keys latched, then the frame runs
+        Scheduler scheduler(chip8, *engine, io);
+        uint16_t keys;
+        while (!chip8.end_of_mem() && movie.next(keys)) {
+            io.set_keys(keys);
+            executed += scheduler.run_frame();
+        }
+        played = scheduler.get_frame_count();
+    }
+    else if (frames > 0) {
+        Scheduler scheduler(chip8, *engine, io);
+        while (scheduler.get_frame_count() < frames && !chip8.end_of_mem())
+            executed += scheduler.run_frame();
+    }
+    else {
+        executed = engine->run(insts);
+    }
+    bool status = chip8.end_of_mem();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::printf("instructions  %llu\n", (unsigned long long)executed);
+    if (play_path)
+        std::printf("frames        %llu\n", (unsigned long long)played);
+    std::printf("presents      %llu\n", (unsigned long long)io.get_draw_count());
+    std::printf("elapsed       %.6f s\n", elapsed.count());
+    std::printf("inst/sec      %.0f\n", elapsed.count() > 0 ? executed / elapsed.count() : 0.0);
+    std::printf("pc %03X  i %03X  dt %02X  st %02X\n", chip8.get_pc(), chip8.get_index(),
+                chip8.get_delay_timer(), chip8.get_sound_timer());
+    for (int i=0; i<16; i++)
+        std::printf("V%X %02X%s", i, chip8.get_var_reg(i), (i % 8 == 7) ? "\n" : "  ");
+
+    if (save_path) {
+        SaveState state;
+        chip8.save(state);
+        if (write_state_file(save_path, state)) {
+            std::cerr << "error: could not write " << save_path << "\n";
+            return 1;
+        }
+    }
+
+    if (profile_path && profiler->write_flat(profile_path)) {
+        std::cerr << "error: could not write " << profile_path << "\n";
+        return 1;
+    }
+
+    if (folded_path && profiler->write_folded(folded_path)) {
+        std::cerr << "error: could not write " << folded_path << "\n";
+        return 1;
+    }
+
+    if (dump_path && !dump_display(dump_path, chip8, palette)) {
+        std::cerr << "error: could not write " << dump_path << "\n";
+        return 1;
+    }
+
+    if (status) {
+        std::cerr << "error: program counter ran past the end of memory\n";
+        return 1;
+    }
+
+    return 0;
+}
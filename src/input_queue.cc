@@ -0,0 +1,143 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+#include "input_queue.hh"
+
+// instructions between two steps, so a wait loop gets to see each state
+constexpr uint64_t min_step_gap = 2;
+
+uint64_t input_clock_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+//////////////////////////////////////////////////
+//                    Queue                     //
+//////////////////////////////////////////////////
+
+InputQueue::InputQueue() {
+    keys = 0;
+    window_start = 0;
+}
+
+bool InputQueue::push(const InputEvent& event) {
+    return ring.push(event);
+}
+
+void InputQueue::drain() {
+    InputEvent event;
+    while (ring.pop(event))
+        pending.push_back(event);
+}
+
+void InputQueue::take_frame(uint64_t now_ns, uint64_t budget, bool per_frame, std::vector<KeyStep>& steps) {
+    drain();
+    steps.clear();
+
+    uint64_t span = (window_start && now_ns > window_start) ? now_ns - window_start : 0;
+    uint16_t changed = 0;
+    size_t used = 0;
+    for (const InputEvent& event : pending) {
+        uint16_t bit = 1 << (event.key & 0xF);
+        uint64_t offset = 0;
+        if (per_frame) {
+            if (changed & bit)
+                break;
+            changed |= bit;
+        }
+        else {
+            // events from before the window (held over) go first
+            if (span && event.time_ns > window_start)
+                offset = std::min(event.time_ns - window_start, span) * budget / span;
+            if (!steps.empty())
+                offset = std::max(offset, steps.back().offset + min_step_gap);
+            if (offset >= budget)
+                break;
+        }
+
+        keys = event.down ? (keys | bit) : (keys & ~bit);
+        steps.push_back(KeyStep{offset, keys, event.time_ns});
+        used++;
+    }
+    pending.erase(pending.begin(), pending.begin() + used);
+    window_start = now_ns;
+}
+
+void InputQueue::skip(uint64_t now_ns) {
+    drain();
+    for (const InputEvent& event : pending) {
+        uint16_t bit = 1 << (event.key & 0xF);
+        keys = event.down ? (keys | bit) : (keys & ~bit);
+    }
+    pending.clear();
+    window_start = now_ns;
+}
+
+uint16_t InputQueue::get_keys() {
+    return keys;
+}
+
+
+//////////////////////////////////////////////////
+//                   Latency                    //
+//////////////////////////////////////////////////
+
+LatencyStats::LatencyStats() {
+    count = 0;
+    total_ns = 0;
+    min_ns = std::numeric_limits<uint64_t>::max();
+    max_ns = 0;
+}
+
+void LatencyStats::add(uint64_t ns) {
+    count++;
+    total_ns += ns;
+    min_ns = std::min(min_ns, ns);
+    max_ns = std::max(max_ns, ns);
+}
+
+uint64_t LatencyStats::get_count() {
+    return count;
+}
+
+uint64_t LatencyStats::get_min_ns() {
+    return count ? min_ns : 0;
+}
+
+uint64_t LatencyStats::get_max_ns() {
+    return max_ns;
+}
+
+uint64_t LatencyStats::get_mean_ns() {
+    return count ? total_ns / count : 0;
+}
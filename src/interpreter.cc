@@ -0,0 +1,157 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include "interpreter.hh"
+#include "log.hh"
+#include "stats.hh"
+
+// the decoder proper, with the quirks fixed at compile time
+template <typename Q>
+static int cycle(Chip8& chip8, Frontend& io) {
+    uint16_t inst = chip8.get_inst();
+    CHIP8_STAT_OP(stat_slot(inst));
+    switch (OP(inst)) {
+    case 0x0:
+        switch (NNN(inst)) {
+        case 0x0E0:    chip8.disp_clear();                               break;
+        case 0x0EE:    chip8.subroutine_return();                        break;
+        case 0x0FB:    chip8.scroll_right();                             break;
+        case 0x0FC:    chip8.scroll_left();                              break;
+        case 0x0FD:    chip8.exit_program();                             break;
+        case 0x0FE:    chip8.set_hires(false);                           break;
+        case 0x0FF:    chip8.set_hires(true);                            break;
+        default:
+            if ((NNN(inst) & 0xFF0) == 0x0C0)
+                chip8.scroll_down(N(inst));
+            else if ((NNN(inst) & 0xFF0) == 0x0D0)
+                chip8.scroll_up(N(inst));
+            break;
+        }
+        break;
+    case 0x1:    chip8.jump(NNN(inst));                                  break;
+    case 0x2:    chip8.subroutine_call(NNN(inst));                       break;
+    case 0x3:    chip8.skip_equal_const(X(inst), NN(inst));              break;
+    case 0x4:    chip8.skip_not_equal_const(X(inst), NN(inst));          break;
+    case 0x5:    chip8.skip_equal(X(inst), Y(inst));                     break;
+    case 0x6:    chip8.set_reg_const(X(inst), NN(inst));                 break;
+    case 0x7:    chip8.add_reg_const(X(inst), NN(inst));                 break;
+    case 0x8:
+        switch (N(inst)) {
+        case 0x0:    chip8.set_reg(X(inst), Y(inst));                    break;
+        case 0x1:    chip8.bitwise_or(X(inst), Y(inst));                 break;
+        case 0x2:    chip8.bitwise_and(X(inst), Y(inst));                break;
+        case 0x3:    chip8.bitwise_xor(X(inst), Y(inst));                break;
+        case 0x4:    chip8.add(X(inst), Y(inst));                        break;
+        case 0x5:    chip8.subtract_x_y(X(inst), Y(inst));               break;
+        case 0x6:    chip8.bitwise_shift_right<Q>(X(inst), Y(inst));     break;
+        case 0x7:    chip8.subtract_y_x(X(inst), Y(inst));               break;
+        case 0xE:    chip8.bitwise_shift_left<Q>(X(inst), Y(inst));      break;
+        }
+        break;
+    case 0x9:    chip8.skip_not_equal(X(inst), Y(inst));                 break;
+    case 0xA:    chip8.set_index(NNN(inst));                             break;
+    case 0xB:    chip8.jump_offset<Q>(NNN(inst));                        break;
+    case 0xC:    chip8.gen_rand(X(inst), NN(inst));                      break;
+    case 0xD:    chip8.draw(X(inst), Y(inst), N(inst));                  break;
+    case 0xE:
+        switch (NN(inst)) {
+        case 0x9E:
+            if (io.key_is_pressed(chip8.get_var_reg(X(inst))))
+                chip8.increment_pc();
+            break;
+        case 0xA1:
+            if (!io.key_is_pressed(chip8.get_var_reg(X(inst))))
+                chip8.increment_pc();
+            break;
+        }
+        break;
+    case 0xF:
+        switch (NN(inst)) {
+        case 0x01:    chip8.select_planes(X(inst));                      break;
+        case 0x07:    chip8.get_delay(X(inst));                          break;
+        case 0x0A:
+            switch (chip8.block_state) {
+            case 0:
+                chip8.block_state = 1;
+                chip8.decrement_pc();
+                break;
+            case 1:
+                if (io.get_curr_key() >= 0) {
+                    chip8.set_reg_const(X(inst), io.get_curr_key());
+                    CHIP8_LOG(Debug, "FX0A: key {} down, V{} set", chip8.get_var_reg(X(inst)), X(inst));
+                    chip8.block_state = 2;
+                }
+                chip8.decrement_pc();
+                break;
+            case 2:
+                if (io.get_curr_key() == -1) {
+                    chip8.block_state = 0;
+                    CHIP8_LOG(Debug, "FX0A: key {} up, V{} done waiting", chip8.get_var_reg(X(inst)), X(inst));
+                }
+                else {
+                    chip8.decrement_pc();
+                }
+                break;
+            }
+            break;
+        case 0x15:    chip8.set_delay(X(inst));                          break;
+        case 0x18:    chip8.set_sound(X(inst));                          break;
+        case 0x1E:    chip8.add_index(X(inst));                          break;
+        case 0x29:    chip8.sprite_index(X(inst));                       break;
+        case 0x30:    chip8.big_sprite_index(X(inst));                   break;
+        case 0x33:    chip8.bcd(X(inst));                                break;
+        case 0x55:    chip8.reg_dump<Q>(X(inst));                        break;
+        case 0x65:    chip8.reg_load<Q>(X(inst));                        break;
+        }
+        break;
+    }
+
+    if (chip8.end_of_mem())
+        return 1;
+
+    return 0;
+}
+
+int instruction_cycle(Chip8& chip8, Frontend& io) {
+    return with_quirks(chip8.get_quirks(), [&]<typename Q>() { return cycle<Q>(chip8, io); });
+}
+
+SwitchEngine::SwitchEngine(Chip8& chip8, Frontend& io) : chip8(chip8), io(io) {}
+
+// quirks are looked at once per run, not once per instruction
+uint64_t SwitchEngine::run(uint64_t n) {
+    return with_quirks(chip8.get_quirks(), [&]<typename Q>() {
+        uint64_t executed = 0;
+        while (executed < n) {
+            executed++;
+            if (cycle<Q>(chip8, io))
+                break;
+        }
+        return executed;
+    });
+}
@@ -0,0 +1,628 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <algorithm>
+#include <cstring>
+
+#include <sys/mman.h>
+
+#include "jit.hh"
+#include "stats.hh"
+
+namespace {
+
+// blocks get compiled once they've been entered this many times
+constexpr uint16_t hot_threshold = 16;
+
+// longest run of instructions compiled into one block
+constexpr int max_block_len = 64;
+
+constexpr size_t code_region_size = 1 << 20;
+
+// x86-64 registers
+enum Reg : int {
+    RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI,
+    R8, R9, R10, R11, R12, R13, R14, R15
+};
+
+// ALU op extensions (81 /ext) & matching register forms (op r/m32, r32)
+enum Alu : int { ADD = 0, OR = 1, AND = 4, SUB = 5, XOR = 6, CMP = 7 };
+constexpr uint8_t alu_rr_opcode[8] = {0x01, 0x09, 0, 0, 0x21, 0x29, 0x31, 0x39};
+
+// shift extensions (C1 /ext ib)
+enum Shift : int { SHL = 4, SHR = 5 };
+
+// condition codes
+enum Cond : int { CC_AE = 0x3, CC_E = 0x4, CC_NE = 0x5 };
+
+// Minimal x86-64 encoder, just the handful of instruction forms the JIT needs.
+// All arithmetic is on 32-bit registers holding zero-extended 8/16-bit values.
+class Emitter {
+public:
+    std::vector<uint8_t> buf;
+
+    void byte(uint8_t b) {
+        buf.push_back(b);
+    }
+
+    void imm32(uint32_t v) {
+        for (int i=0; i<4; i++)
+            byte((v >> (i * 8)) & 0xFF);
+    }
+
+    // force - emit even with no bits set (needed for spl/bpl/sil/dil byte regs)
+    void rex(int r, int x, int b, bool force = false) {
+        uint8_t bits = ((r >> 3) << 2) | ((x >> 3) << 1) | (b >> 3);
+        if (bits || force)
+            byte(0x40 | bits);
+    }
+
+    void modrm(int mod, int reg, int rm) {
+        byte((mod << 6) | ((reg & 7) << 3) | (rm & 7));
+    }
+
+    // mov dst, src
+    void mov(Reg dst, Reg src) {
+        rex(src, 0, dst);
+        byte(0x89);
+        modrm(3, src, dst);
+    }
+
+    // mov dst, imm32
+    void mov_imm(Reg dst, uint32_t imm) {
+        rex(0, 0, dst);
+        byte(0xB8 + (dst & 7));
+        imm32(imm);
+    }
+
+    // op dst, src
+    void alu(Alu op, Reg dst, Reg src) {
+        rex(src, 0, dst);
+        byte(alu_rr_opcode[op]);
+        modrm(3, src, dst);
+    }
+
+    // op dst, imm32
+    void alu_imm(Alu op, Reg dst, uint32_t imm) {
+        rex(0, 0, dst);
+        byte(0x81);
+        modrm(3, op, dst);
+        imm32(imm);
+    }
+
+    // shl / shr dst, imm8
+    void shift(Shift op, Reg dst, uint8_t imm) {
+        rex(0, 0, dst);
+        byte(0xC1);
+        modrm(3, op, dst);
+        byte(imm);
+    }
+
+    // movzx dst, src8
+    void movzx8(Reg dst, Reg src) {
+        rex(dst, 0, src, src >= RSP && src <= RDI);
+        byte(0x0F);
+        byte(0xB6);
+        modrm(3, dst, src);
+    }
+
+    // movzx dst, byte [base + disp8]
+    void load8(Reg dst, Reg base, uint8_t disp) {
+        rex(dst, 0, base);
+        byte(0x0F);
+        byte(0xB6);
+        modrm(1, dst, base);
+        byte(disp);
+    }
+
+    // mov byte [base + disp8], src8
+    void store8(Reg base, uint8_t disp, Reg src) {
+        rex(src, 0, base, src >= RSP && src <= RDI);
+        byte(0x88);
+        modrm(1, src, base);
+        byte(disp);
+    }
+
+    // movzx dst, byte [base + index + disp8]
+    void load8_indexed(Reg dst, Reg base, Reg index, uint8_t disp) {
+        rex(dst, index, base);
+        byte(0x0F);
+        byte(0xB6);
+        modrm(1, dst, 4);
+        byte(((index & 7) << 3) | (base & 7));
+        byte(disp);
+    }
+
+    // movzx dst, word [base]
+    void load16(Reg dst, Reg base) {
+        rex(dst, 0, base);
+        byte(0x0F);
+        byte(0xB7);
+        modrm(0, dst, base);
+    }
+
+    // mov word [base], src16
+    void store16(Reg base, Reg src) {
+        byte(0x66);
+        rex(src, 0, base);
+        byte(0x89);
+        modrm(0, src, base);
+    }
+
+    // lea dst, [src + src*4]
+    void times5(Reg dst, Reg src) {
+        rex(dst, src, src);
+        byte(0x8D);
+        modrm(0, dst, 4);
+        byte((2 << 6) | ((src & 7) << 3) | (src & 7));
+    }
+
+    // setcc dst8
+    void setcc(Cond cc, Reg dst) {
+        rex(0, 0, dst, dst >= RSP && dst <= RDI);
+        byte(0x0F);
+        byte(0x90 + cc);
+        modrm(3, 0, dst);
+    }
+
+    // cmovcc dst, src
+    void cmov(Cond cc, Reg dst, Reg src) {
+        rex(dst, 0, src);
+        byte(0x0F);
+        byte(0x40 + cc);
+        modrm(3, dst, src);
+    }
+
+    void push(Reg r) {
+        rex(0, 0, r);
+        byte(0x50 + (r & 7));
+    }
+
+    void pop(Reg r) {
+        rex(0, 0, r);
+        byte(0x58 + (r & 7));
+    }
+
+    void ret() {
+        byte(0xC3);
+    }
+};
+
+enum class Kind { Body, Terminator, Interpreted };
+
+Kind classify(uint16_t inst) {
+    switch ((inst & 0xF000) >> 12) {
+    case 0x0:
+        switch (inst) {
+        case 0x00E0:
+        case 0x00EE:
+        case 0x00FB:
+        case 0x00FC:
+        case 0x00FD:
+        case 0x00FE:
+        case 0x00FF:    return Kind::Interpreted;
+        }
+        // 00CN / 00DN scrolls
+        if ((inst & 0xFFE0) == 0x00C0)
+            return Kind::Interpreted;
+        return Kind::Body;
+    case 0x1:
+    case 0x3:
+    case 0x4:
+    case 0x5:
+    case 0x9:
+    case 0xB:
+        return Kind::Terminator;
+    case 0x2:
+    case 0xC:
+    case 0xD:
+        return Kind::Interpreted;
+    case 0xE:
+        switch (inst & 0x00FF) {
+        case 0x9E:
+        case 0xA1:    return Kind::Interpreted;
+        }
+        return Kind::Body;
+    case 0xF:
+        switch (inst & 0x00FF) {
+        case 0x01:
+        case 0x07:
+        case 0x0A:
+        case 0x15:
+        case 0x18:
+        case 0x30:
+        case 0x33:
+        case 0x55:    return Kind::Interpreted;
+        }
+        return Kind::Body;
+    }
+    return Kind::Body;
+}
+
+// V registers an instruction reads or writes, as a bitmask
+uint32_t regs_used(uint16_t inst, bool jump_offset_vx) {
+    uint8_t x = (inst & 0x0F00) >> 8;
+    uint8_t y = (inst & 0x00F0) >> 4;
+    switch ((inst & 0xF000) >> 12) {
+    case 0x3:
+    case 0x4:
+    case 0x6:
+    case 0x7:    return 1u << x;
+    case 0x5:
+    case 0x9:    return (1u << x) | (1u << y);
+    case 0x8:    return (1u << x) | (1u << y) | (1u << 0xF);
+    case 0xB:    return 1u << (jump_offset_vx ? x : 0);
+    case 0xF:
+        switch (inst & 0x00FF) {
+        case 0x1E:
+        case 0x29:    return 1u << x;
+        case 0x65:    return (2u << x) - 1;
+        }
+    }
+    return 0;
+}
+
+}
+
+Jit::Jit(Chip8& chip8, Frontend& io) : chip8(chip8), fallback(chip8, io) {
+    region_size = code_region_size;
+    region_used = 0;
+    void* mem = mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    region = (mem == MAP_FAILED) ? nullptr : static_cast<uint8_t*>(mem);
+
+    invalidate_all();
+    chip8.watch_memory(this);
+}
+
+Jit::~Jit() {
+    chip8.watch_memory(nullptr);
+    if (region)
+        munmap(region, region_size);
+}
+
+uint64_t Jit::run(uint64_t n) {
+    uint8_t* v = chip8.var_regs.data();
+    uint8_t* mem = chip8.memory.data();
+    uint16_t* index = &chip8.index_register;
+
+    // compiled code has the quirks baked in
+    if (fallback.sync_quirks())
+        invalidate_all();
+
+    uint64_t executed = 0;
+    while (executed < n && !chip8.end_of_mem()) {
+        JitBlock& block = jit_at[chip8.program_counter];
+
+        if (!block.code && !block.uncompilable && ++block.heat >= hot_threshold)
+            compile(chip8.program_counter);
+
+        if (block.code && block.len <= n - executed) {
+#ifdef CHIP8_STATS
+            StatCounters& counters = stat_counters();
+            for (uint16_t i=0; i<block.len; i++)
+                stat_add(counters.ops[stat_at[chip8.program_counter + 2 * i]], 1);
+#endif
+            chip8.program_counter = block.code(v, mem, index);
+            executed += block.len;
+        }
+        else {
+            executed += fallback.run_block(n - executed);
+        }
+    }
+    return executed;
+}
+
+void Jit::on_write(uint16_t addr, uint16_t len) {
+    fallback.on_write(addr, len);
+
+    int first = addr;
+    int last  = std::min(int(addr) + int(len) - 1, 0xFFF);
+
+    // an instruction that couldn't be compiled may have just become one that can
+    for (int a=std::max(first - 1, 0); a<=last; a++)
+        jit_at[a].uncompilable = false;
+
+    bool hit = false;
+    for (int a=first; a<=last; a++)
+        hit |= code_bytes[a];
+    if (!hit)
+        return;
+
+    // drop every compiled block overlapping the write, then rebuild the coverage.
+    // the code itself stays in the region until the next flush
+    code_bytes.reset();
+    for (int start=0; start<0x1000; start++) {
+        JitBlock& block = jit_at[start];
+        if (!block.code)
+            continue;
+
+        if (start <= last && block.end > first) {
+            block = JitBlock{nullptr, 0, 0, 0, false};
+        }
+        else {
+            for (int a=start; a<block.end && a<=0xFFF; a++)
+                code_bytes[a] = true;
+        }
+    }
+}
+
+void Jit::invalidate_all() {
+    std::fill(jit_at.begin(), jit_at.end(), JitBlock{nullptr, 0, 0, 0, false});
+    code_bytes.reset();
+    region_used = 0;
+}
+
+bool Jit::compile(uint16_t start) {
+    JitBlock& block = jit_at[start];
+
+    // collect the run of instructions to compile
+    std::vector<uint16_t> insts;
+    uint16_t addr = start;
+    bool terminated = false;
+    while (insts.size() < max_block_len && addr <= 0xFFE) {
+        uint16_t inst = (chip8.memory[addr] << 8) | chip8.memory[addr + 1];
+        Kind kind = classify(inst);
+        if (kind == Kind::Interpreted)
+            break;
+        insts.push_back(inst);
+#ifdef CHIP8_STATS
+        stat_at[addr] = stat_slot(inst);
+#endif
+        addr += 2;
+        if (kind == Kind::Terminator) {
+            terminated = true;
+            break;
+        }
+    }
+
+    if (insts.empty() || !region) {
+        block.uncompilable = true;
+        return false;
+    }
+
+    // give the most used V registers a host register each, the rest stay in memory
+    std::array<int, 16> uses{};
+    for (uint16_t inst : insts) {
+        uint32_t mask = regs_used(inst, chip8.jump_offset_vx);
+        for (int r=0; r<16; r++)
+            uses[r] += (mask >> r) & 1;
+    }
+    std::array<int, 16> order;
+    for (int r=0; r<16; r++)
+        order[r] = r;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return uses[a] > uses[b]; });
+
+    // rax, rcx scratch - rdx &I - rsi memory - rdi V0-VF - r8 I
+    const Reg pool[] = {R9, R10, R11, RBX, RBP, R12, R13, R14, R15};
+    std::array<int, 16> host;
+    host.fill(-1);
+    std::vector<Reg> saved;
+    for (size_t i=0; i<std::size(pool) && uses[order[i]] > 0; i++) {
+        host[order[i]] = pool[i];
+        if (pool[i] == RBX || pool[i] == RBP || pool[i] >= R12)
+            saved.push_back(pool[i]);
+    }
+    std::array<bool, 16> written{};
+
+    Emitter e;
+    auto load_v = [&](Reg dst, int x) {
+        if (host[x] >= 0)
+            e.mov(dst, Reg(host[x]));
+        else
+            e.load8(dst, RDI, x);
+    };
+    auto store_v = [&](int x, Reg src) {
+        if (host[x] >= 0) {
+            e.mov(Reg(host[x]), src);
+            written[x] = true;
+        }
+        else {
+            e.store8(RDI, x, src);
+        }
+    };
+
+    // prologue
+    for (Reg r : saved)
+        e.push(r);
+    e.load16(R8, RDX);
+    for (int r=0; r<16; r++) {
+        if (host[r] >= 0)
+            e.load8(Reg(host[r]), RDI, r);
+    }
+
+    uint16_t pc = start;
+    for (uint16_t inst : insts) {
+        uint8_t x = (inst & 0x0F00) >> 8;
+        uint8_t y = (inst & 0x00F0) >> 4;
+        uint8_t nn = inst & 0x00FF;
+        uint16_t nnn = inst & 0x0FFF;
+
+        switch ((inst & 0xF000) >> 12) {
+        case 0x1:    // 1NNN
+            e.mov_imm(RAX, nnn);
+            break;
+        case 0x3:    // 3XNN
+        case 0x4:    // 4XNN
+            load_v(RAX, x);
+            e.alu_imm(CMP, RAX, nn);
+            e.mov_imm(RAX, pc + 2);
+            e.mov_imm(RCX, pc + 4);
+            e.cmov((inst & 0xF000) == 0x3000 ? CC_E : CC_NE, RAX, RCX);
+            break;
+        case 0x5:    // 5XY0
+        case 0x9:    // 9XY0
+            load_v(RAX, x);
+            load_v(RCX, y);
+            e.alu(CMP, RAX, RCX);
+            e.mov_imm(RAX, pc + 2);
+            e.mov_imm(RCX, pc + 4);
+            e.cmov((inst & 0xF000) == 0x5000 ? CC_E : CC_NE, RAX, RCX);
+            break;
+        case 0x6:    // 6XNN
+            e.mov_imm(RAX, nn);
+            store_v(x, RAX);
+            break;
+        case 0x7:    // 7XNN
+            load_v(RAX, x);
+            e.alu_imm(ADD, RAX, nn);
+            e.movzx8(RAX, RAX);
+            store_v(x, RAX);
+            break;
+        case 0x8:
+            switch (inst & 0x000F) {
+            case 0x0:    // 8XY0
+                load_v(RAX, y);
+                store_v(x, RAX);
+                break;
+            case 0x1:    // 8XY1
+            case 0x2:    // 8XY2
+            case 0x3:    // 8XY3
+                load_v(RAX, x);
+                load_v(RCX, y);
+                e.alu((inst & 0xF) == 1 ? OR : (inst & 0xF) == 2 ? AND : XOR, RAX, RCX);
+                store_v(x, RAX);
+                break;
+            case 0x4:    // 8XY4 - VF = carry
+                load_v(RAX, x);
+                load_v(RCX, y);
+                e.alu(ADD, RAX, RCX);
+                e.mov(RCX, RAX);
+                e.shift(SHR, RCX, 8);
+                e.movzx8(RAX, RAX);
+                store_v(x, RAX);
+                store_v(0xF, RCX);
+                break;
+            case 0x5:    // 8XY5 - VF = no borrow
+            case 0x7:    // 8XY7 - VF = no borrow
+                load_v(RAX, (inst & 0xF) == 5 ? x : y);
+                load_v(RCX, (inst & 0xF) == 5 ? y : x);
+                e.alu(SUB, RAX, RCX);
+                e.setcc(CC_AE, RCX);
+                e.movzx8(RCX, RCX);
+                e.movzx8(RAX, RAX);
+                store_v(x, RAX);
+                store_v(0xF, RCX);
+                break;
+            case 0x6:    // 8XY6
+                load_v(RAX, chip8.shift_use_vy ? y : x);
+                e.mov(RCX, RAX);
+                e.alu_imm(AND, RCX, 1);
+                e.shift(SHR, RAX, 1);
+                store_v(x, RAX);
+                store_v(0xF, RCX);
+                break;
+            case 0xE:    // 8XYE
+                load_v(RAX, chip8.shift_use_vy ? y : x);
+                e.mov(RCX, RAX);
+                e.shift(SHR, RCX, 7);
+                e.shift(SHL, RAX, 1);
+                e.movzx8(RAX, RAX);
+                store_v(x, RAX);
+                store_v(0xF, RCX);
+                break;
+            }
+            break;
+        case 0xA:    // ANNN
+            e.mov_imm(R8, nnn);
+            break;
+        case 0xB:    // BNNN
+            load_v(RAX, chip8.jump_offset_vx ? x : 0);
+            e.alu_imm(ADD, RAX, nnn);
+            break;
+        case 0xF:
+            switch (nn) {
+            case 0x1E:    // FX1E
+                load_v(RAX, x);
+                e.alu(ADD, R8, RAX);
+                e.alu_imm(AND, R8, 0xFFFF);
+                break;
+            case 0x29:    // FX29
+                load_v(RAX, x);
+                e.times5(RAX, RAX);
+                e.alu_imm(ADD, RAX, 0x050);
+                e.mov(R8, RAX);
+                break;
+            case 0x65:    // FX65 - addresses wrap to 12 bits, as in Chip8::reg_load
+                for (int i=0; i<=x; i++) {
+                    e.mov(RCX, R8);
+                    if (i)
+                        e.alu_imm(ADD, RCX, i);
+                    e.alu_imm(AND, RCX, 0xFFF);
+                    e.load8_indexed(RAX, RSI, RCX, 0);
+                    store_v(i, RAX);
+                }
+                if (chip8.store_load_i_inc) {
+                    e.alu_imm(ADD, R8, x + 1);
+                    e.alu_imm(AND, R8, 0xFFFF);
+                }
+                break;
+            }
+            break;
+        }
+        pc += 2;
+    }
+
+    // next program counter - terminators have already put theirs in eax
+    if (!terminated)
+        e.mov_imm(RAX, pc);
+
+    // epilogue
+    e.store16(RDX, R8);
+    for (int r=0; r<16; r++) {
+        if (host[r] >= 0 && written[r])
+            e.store8(RDI, r, Reg(host[r]));
+    }
+    for (auto r = saved.rbegin(); r != saved.rend(); r++)
+        e.pop(*r);
+    e.ret();
+
+    // copy into the executable region, flushing everything if it's full.
+    // the region is only ever writable or executable, never both
+    if (region_used + e.buf.size() > region_size)
+        invalidate_all();
+
+    if (mprotect(region, region_size, PROT_READ | PROT_WRITE)) {
+        block.uncompilable = true;
+        return false;
+    }
+    std::memcpy(region + region_used, e.buf.data(), e.buf.size());
+    if (mprotect(region, region_size, PROT_READ | PROT_EXEC)) {
+        block.uncompilable = true;
+        return false;
+    }
+
+    block.code = reinterpret_cast<JitCode>(region + region_used);
+    block.end = pc;
+    block.len = insts.size();
+    region_used += e.buf.size();
+
+    for (int a=start; a<pc; a++)
+        code_bytes[a] = true;
+
+    return true;
+}
@@ -0,0 +1,780 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <algorithm>
+#include <climits>
+
+#include "chip8.hh"
+#include "interpreter.hh"
+#include "lockstep.hh"
+
+// The lane kernels below are plain loops over every lane, masked by select
+// rather than by branching so they vectorise. On x86-64 each is built twice,
+// for AVX2 & baseline, and the loader picks one for the running CPU.
+#if defined(__x86_64__) && defined(__GNUC__)
+#define LANE_KERNEL __attribute__((target_clones("avx2", "default")))
+#else
+#define LANE_KERNEL
+#endif
+
+namespace {
+
+constexpr size_t lane_width = 32;     // bytes in an AVX2 vector
+
+// m is 0 or 1 - a where it's set, b where it isn't. Done with masks instead of
+// ?: so the compiler never turns it back into a branch.
+template <typename T>
+inline T blend(uint8_t m, T a, T b) {
+    T all = T(0) - T(m);
+    return T((a & all) | (b & ~all));
+}
+
+//////////////////////////////////////////////////
+//                   Grouping                   //
+//////////////////////////////////////////////////
+
+// lowest program counter among lanes with budget left, 0xFFFF if none
+LANE_KERNEL
+uint16_t lead_pc(const uint16_t* pc, const uint32_t* left, size_t n) {
+    uint16_t lead = 0xFFFF;
+    for (size_t l=0; l<n; l++) {
+        uint8_t live = (left[l] != 0) & (pc[l] <= 0xFFF);
+        lead = std::min(lead, blend<uint16_t>(live, pc[l], 0xFFFF));
+    }
+    return lead;
+}
+
+// mask in the lanes sitting on lead, returns the smallest budget among them
+LANE_KERNEL
+uint32_t form_group(const uint16_t* pc, const uint32_t* left, uint16_t lead, uint8_t* mask,
+                    size_t& members, size_t n) {
+    uint32_t steps = UINT32_MAX;
+    uint32_t count = 0;
+    for (size_t l=0; l<n; l++) {
+        uint8_t m = (left[l] != 0) & (pc[l] == lead);
+        mask[l] = m;
+        count += m;
+        steps = std::min(steps, blend<uint32_t>(m, left[l], UINT32_MAX));
+    }
+    members = count;
+    return steps;
+}
+
+// masked lanes step past the instruction they're about to execute
+LANE_KERNEL
+void step(uint16_t* pc, uint32_t* left, const uint8_t* mask, size_t n) {
+    for (size_t l=0; l<n; l++) {
+        pc[l] += uint16_t(mask[l]) << 1;
+        left[l] -= mask[l];
+    }
+}
+
+//////////////////////////////////////////////////
+//                 Lane Kernels                 //
+//////////////////////////////////////////////////
+
+// 6XNN
+LANE_KERNEL
+void set_const(uint8_t* v, uint8_t nn, const uint8_t* mask, size_t n) {
+    for (size_t l=0; l<n; l++)
+        v[l] = blend(mask[l], nn, v[l]);
+}
+
+// 7XNN
+LANE_KERNEL
+void add_const(uint8_t* v, uint8_t nn, const uint8_t* mask, size_t n) {
+    for (size_t l=0; l<n; l++)
+        v[l] += blend<uint8_t>(mask[l], nn, 0);
+}
+
+// FX07, FX15, FX18
+LANE_KERNEL
+void copy(uint8_t* dst, const uint8_t* src, const uint8_t* mask, size_t n) {
+    for (size_t l=0; l<n; l++)
+        dst[l] = blend(mask[l], src[l], dst[l]);
+}
+
+// 8XYN - flags are computed from the operands before either is written, & VF
+// is written last, same as Chip8
+LANE_KERNEL
+void alu(uint8_t op, uint8_t* vx, const uint8_t* vy, uint8_t* vf, bool shift_use_vy,
+         const uint8_t* mask, size_t n) {
+    switch (op) {
+    case 0x0:
+        for (size_t l=0; l<n; l++)
+            vx[l] = blend(mask[l], vy[l], vx[l]);
+        break;
+    case 0x1:
+        for (size_t l=0; l<n; l++)
+            vx[l] = blend<uint8_t>(mask[l], vx[l] | vy[l], vx[l]);
+        break;
+    case 0x2:
+        for (size_t l=0; l<n; l++)
+            vx[l] = blend<uint8_t>(mask[l], vx[l] & vy[l], vx[l]);
+        break;
+    case 0x3:
+        for (size_t l=0; l<n; l++)
+            vx[l] = blend<uint8_t>(mask[l], vx[l] ^ vy[l], vx[l]);
+        break;
+    case 0x4:
+        for (size_t l=0; l<n; l++) {
+            uint8_t a = vx[l], b = vy[l];
+            uint8_t sum = a + b;
+            vx[l] = blend(mask[l], sum, a);
+            vf[l] = blend<uint8_t>(mask[l], sum < a, vf[l]);
+        }
+        break;
+    case 0x5:
+        for (size_t l=0; l<n; l++) {
+            uint8_t a = vx[l], b = vy[l];
+            vx[l] = blend<uint8_t>(mask[l], a - b, a);
+            vf[l] = blend<uint8_t>(mask[l], a >= b, vf[l]);
+        }
+        break;
+    case 0x6:
+        for (size_t l=0; l<n; l++) {
+            uint8_t a = shift_use_vy ? vy[l] : vx[l];
+            vx[l] = blend<uint8_t>(mask[l], a >> 1, vx[l]);
+            vf[l] = blend<uint8_t>(mask[l], a & 0x01, vf[l]);
+        }
+        break;
+    case 0x7:
+        for (size_t l=0; l<n; l++) {
+            uint8_t a = vx[l], b = vy[l];
+            vx[l] = blend<uint8_t>(mask[l], b - a, a);
+            vf[l] = blend<uint8_t>(mask[l], b >= a, vf[l]);
+        }
+        break;
+    case 0xE:
+        for (size_t l=0; l<n; l++) {
+            uint8_t a = shift_use_vy ? vy[l] : vx[l];
+            vx[l] = blend<uint8_t>(mask[l], a << 1, vx[l]);
+            vf[l] = blend<uint8_t>(mask[l], a >> 7, vf[l]);
+        }
+        break;
+    }
+}
+
+// 3XNN, 4XNN
+LANE_KERNEL
+void skip_const(uint16_t* pc, const uint8_t* v, uint8_t nn, bool equal, const uint8_t* mask, size_t n) {
+    for (size_t l=0; l<n; l++)
+        pc[l] += uint16_t(mask[l] & ((v[l] == nn) == equal)) << 1;
+}
+
+// 5XY0, 9XY0
+LANE_KERNEL
+void skip_reg(uint16_t* pc, const uint8_t* vx, const uint8_t* vy, bool equal, const uint8_t* mask, size_t n) {
+    for (size_t l=0; l<n; l++)
+        pc[l] += uint16_t(mask[l] & ((vx[l] == vy[l]) == equal)) << 1;
+}
+
+// EX9E, EXA1
+LANE_KERNEL
+void skip_key(uint16_t* pc, const uint16_t* keys, const uint8_t* v, bool pressed, const uint8_t* mask, size_t n) {
+    for (size_t l=0; l<n; l++) {
+        uint32_t down = (uint32_t(keys[l]) >> (v[l] & 0xF)) & 1;
+        pc[l] += uint16_t(mask[l] & (down == pressed)) << 1;
+    }
+}
+
+// 1NNN, ANNN
+LANE_KERNEL
+void set_16(uint16_t* dst, uint16_t nnn, const uint8_t* mask, size_t n) {
+    for (size_t l=0; l<n; l++)
+        dst[l] = blend(mask[l], nnn, dst[l]);
+}
+
+// BNNN
+LANE_KERNEL
+void jump_offset(uint16_t* pc, const uint8_t* v, uint16_t nnn, const uint8_t* mask, size_t n) {
+    for (size_t l=0; l<n; l++)
+        pc[l] = blend<uint16_t>(mask[l], nnn + v[l], pc[l]);
+}
+
+// FX1E
+LANE_KERNEL
+void add_index(uint16_t* index, const uint8_t* v, const uint8_t* mask, size_t n) {
+    for (size_t l=0; l<n; l++)
+        index[l] += blend<uint16_t>(mask[l], v[l], 0);
+}
+
+// FX29
+LANE_KERNEL
+void sprite_index(uint16_t* index, const uint8_t* v, const uint8_t* mask, size_t n) {
+    for (size_t l=0; l<n; l++)
+        index[l] = blend<uint16_t>(mask[l], 0x050 + v[l] * 5, index[l]);
+}
+
+// FX30 - 8x10 digits follow the small font, see Chip8::big_sprite_index
+LANE_KERNEL
+void big_sprite_index(uint16_t* index, const uint8_t* v, const uint8_t* mask, size_t n) {
+    for (size_t l=0; l<n; l++)
+        index[l] = blend<uint16_t>(mask[l], 0x0A0 + (v[l] & 0xF) * 10, index[l]);
+}
+
+// CXNN - same xorshift64* step as Chip8::gen_rand, one generator per lane
+LANE_KERNEL
+void gen_rand(uint64_t* state, uint8_t* v, uint8_t nn, const uint8_t* mask, size_t n) {
+    for (size_t l=0; l<n; l++) {
+        uint64_t s = state[l];
+        s ^= s >> 12;
+        s ^= s << 25;
+        s ^= s >> 27;
+        state[l] = blend(mask[l], s, state[l]);
+        v[l] = blend<uint8_t>(mask[l], uint8_t((s * 0x2545F4914F6CDD1D) >> 56) & nn, v[l]);
+    }
+}
+
+LANE_KERNEL
+void tick(uint8_t* timer, size_t n) {
+    for (size_t l=0; l<n; l++)
+        timer[l] -= (timer[l] > 0);
+}
+
+}
+
+Lockstep::Lockstep(const SaveState& state, size_t count) {
+    lanes = count;
+    stride = std::max(lane_width, (count + lane_width - 1) / lane_width * lane_width);
+
+    for (auto& v : var_regs)
+        v.assign(stride, 0);
+    for (auto& s : stack)
+        s.assign(stride, 0);
+    index_register.assign(stride, 0);
+    program_counter.assign(stride, 0xFFFF);     // padding lanes sit past the end of memory
+    delay_timer.assign(stride, 0);
+    sound_timer.assign(stride, 0);
+    stack_pointer.assign(stride, 0);
+    block_state.assign(stride, 0);
+    rng_state.assign(stride, 1);
+    keys.assign(stride, 0);
+    last_key_down.assign(stride, -1);
+    memory.assign(lanes * 4096, 0);
+    display.assign(lanes * 32, 0);
+    left.assign(stride, 0);
+    mask.assign(stride, 0);
+    unsupported.assign(stride, 0);
+
+    image = state.memory;
+    written.reset();
+
+    inst_per_sec = state.inst_per_sec;
+    shift_use_vy = state.shift_use_vy;
+    jump_offset_vx = state.jump_offset_vx;
+    store_load_i_inc = state.store_load_i_inc;
+    frame_count = 0;
+
+    group_steps = 0;
+    lane_steps = 0;
+
+    for (size_t l=0; l<lanes; l++)
+        load_lane(l, state);
+}
+
+size_t Lockstep::get_lanes() {
+    return lanes;
+}
+
+double Lockstep::get_occupancy() {
+    return group_steps ? double(lane_steps) / group_steps : 0.0;
+}
+
+
+//////////////////////////////////////////////////
+//                    Lanes                     //
+//////////////////////////////////////////////////
+
+void Lockstep::save_lane(size_t lane, SaveState& state) {
+    state.magic = SaveState::magic_value;
+    state.version = SaveState::current_version;
+
+    std::copy_n(lane_memory(lane), 4096, state.memory.begin());
+
+    // lanes are always lores on plane 1 - word 0 of plane 1's first 32 rows
+    std::fill(state.display.begin(), state.display.end(), 0);
+    for (int r=0; r<32; r++)
+        state.display[r * Screen::row_words] = lane_display(lane)[r];
+    state.hires = 0;
+    state.plane_mask = 1;
+    for (int i=0; i<16; i++) {
+        state.stack[i] = stack[i][lane];
+        state.var_regs[i] = var_regs[i][lane];
+    }
+
+    state.index_register = index_register[lane];
+    state.program_counter = program_counter[lane];
+    state.delay_timer = delay_timer[lane];
+    state.sound_timer = sound_timer[lane];
+    state.stack_pointer = stack_pointer[lane];
+    state.block_state = block_state[lane];
+
+    state.inst_per_sec = inst_per_sec;
+    state.shift_use_vy = shift_use_vy;
+    state.jump_offset_vx = jump_offset_vx;
+    state.store_load_i_inc = store_load_i_inc;
+    std::fill(std::begin(state.reserved), std::end(state.reserved), 0);
+    state.rng_state = rng_state[lane];
+}
+
+int Lockstep::load_lane(size_t lane, const SaveState& state) {
+    if (state.magic != SaveState::magic_value || state.version != SaveState::current_version)
+        return 1;
+
+    // no hires or second plane in a lane
+    if (state.hires || state.plane_mask != 1)
+        return 1;
+
+    std::copy(state.memory.begin(), state.memory.end(), lane_memory(lane));
+    for (int r=0; r<32; r++)
+        lane_display(lane)[r] = state.display[r * Screen::row_words];
+    for (int i=0; i<16; i++) {
+        stack[i][lane] = state.stack[i];
+        var_regs[i][lane] = state.var_regs[i];
+    }
+
+    index_register[lane] = state.index_register;
+    program_counter[lane] = state.program_counter;
+    delay_timer[lane] = state.delay_timer;
+    sound_timer[lane] = state.sound_timer;
+    stack_pointer[lane] = std::min<uint8_t>(state.stack_pointer, 16);
+    block_state[lane] = state.block_state;
+    rng_state[lane] = state.rng_state ? state.rng_state : 1;
+    unsupported[lane] = 0;
+
+    // code fetched from anywhere this lane differs has to be checked per lane
+    for (size_t addr=0; addr<4096; addr++) {
+        if (state.memory[addr] != image[addr])
+            written.set(addr);
+    }
+
+    return 0;
+}
+
+void Lockstep::set_keys(size_t lane, uint16_t new_keys) {
+    // same "last key down" tracking as HeadlessFrontend::set_keys
+    uint16_t pressed = new_keys & ~keys[lane];
+    for (int i=15; i>=0; i--) {
+        if (pressed & (1 << i)) {
+            last_key_down[lane] = i;
+            break;
+        }
+    }
+    if (last_key_down[lane] >= 0 && !(new_keys & (1 << last_key_down[lane])))
+        last_key_down[lane] = -1;
+
+    keys[lane] = new_keys;
+}
+
+void Lockstep::seed_rand(size_t lane, uint64_t seed) {
+    rng_state[lane] = Chip8::mix_seed(seed);
+}
+
+bool Lockstep::end_of_mem(size_t lane) {
+    return (program_counter[lane] > 0xFFF);
+}
+
+uint8_t Lockstep::get_var_reg(size_t lane, uint8_t x) {
+    return var_regs[x][lane];
+}
+
+uint16_t Lockstep::get_index(size_t lane) {
+    return index_register[lane];
+}
+
+uint16_t Lockstep::get_pc(size_t lane) {
+    return program_counter[lane];
+}
+
+bool Lockstep::is_unsupported(size_t lane) {
+    return unsupported[lane];
+}
+
+std::span<const uint64_t, 32> Lockstep::get_display(size_t lane) {
+    return std::span<const uint64_t, 32>(lane_display(lane), 32);
+}
+
+
+//////////////////////////////////////////////////
+//                     Run                      //
+//////////////////////////////////////////////////
+
+uint64_t Lockstep::run(uint64_t n) {
+    uint64_t executed = 0;
+
+    while (n > 0) {
+        uint32_t chunk = std::min<uint64_t>(n, UINT32_MAX);
+
+        size_t runnable = 0;
+        for (size_t l=0; l<lanes; l++) {
+            left[l] = (program_counter[l] <= 0xFFF && !unsupported[l]) ? chunk : 0;
+            runnable += (left[l] != 0);
+        }
+
+        run_chunk();
+
+        executed += uint64_t(chunk) * runnable;
+        for (size_t l=0; l<lanes; l++)
+            executed -= left[l];
+
+        n -= chunk;
+    }
+
+    return executed;
+}
+
+uint64_t Lockstep::run_frame() {
+    // same spread of inst_per_sec over each second as Scheduler::run_frame
+    uint64_t ips = inst_per_sec;
+    uint64_t second_frame = frame_count % 60;
+    uint64_t budget = (second_frame + 1) * ips / 60 - second_frame * ips / 60;
+
+    uint64_t executed = run(budget);
+    tick_timers();
+    frame_count++;
+
+    return executed;
+}
+
+void Lockstep::tick_timers() {
+    tick(delay_timer.data(), stride);
+    tick(sound_timer.data(), stride);
+}
+
+void Lockstep::run_chunk() {
+    while (true) {
+        uint16_t lead = lead_pc(program_counter.data(), left.data(), stride);
+        if (lead > 0xFFF)
+            return;
+
+        size_t members;
+        uint32_t steps = form_group(program_counter.data(), left.data(), lead, mask.data(), members, stride);
+
+        size_t first = std::find(mask.begin(), mask.end(), 1) - mask.begin();
+        run_group(lead, first, steps, members);
+    }
+}
+
+// step every lane in the mask through the code at pc together, for at most
+// steps instructions, until one that can split them up
+void Lockstep::run_group(uint16_t pc, size_t first, uint32_t steps, size_t members) {
+    for (uint32_t s=0; s<steps && pc <= 0xFFF; s++) {
+        const uint8_t* code = lane_memory(first);
+        uint16_t inst = (code[pc] << 8) | code[(pc + 1) & 0xFFF];
+
+        // lanes that rewrote this instruction wait for a later group - the
+        // first lane always runs what it fetched, so every group makes progress
+        if (written[pc] || written[(pc + 1) & 0xFFF]) {
+            for (size_t l=first+1; l<lanes; l++) {
+                const uint8_t* lane_code = lane_memory(l);
+                if (mask[l] && ((lane_code[pc] << 8) | lane_code[(pc + 1) & 0xFFF]) != inst) {
+                    mask[l] = 0;
+                    members--;
+                }
+            }
+        }
+
+        group_steps++;
+        lane_steps += members;
+
+        step(program_counter.data(), left.data(), mask.data(), stride);
+        pc += 2;
+
+        if (!execute(inst))
+            return;
+
+        // 1NNN sends the whole group to the same place
+        if (OP(inst) == 0x1)
+            pc = NNN(inst);
+    }
+}
+
+// one instruction for every lane in the mask, program counters already
+// stepped past it - false if the lanes may no longer all be at the same place
+bool Lockstep::execute(uint16_t inst) {
+    const uint8_t* m = mask.data();
+    size_t n = stride;
+    uint8_t x = X(inst);
+    uint8_t y = Y(inst);
+
+    switch (OP(inst)) {
+    case 0x0:
+        switch (NNN(inst)) {
+        case 0x0E0:
+        case 0x0FE:     // back to lores - already there, but the display is cleared
+            for (size_t l=0; l<lanes; l++) {
+                if (m[l])
+                    std::fill_n(lane_display(l), 32, 0);
+            }
+            break;
+        case 0x0EE:
+            for (size_t l=0; l<lanes; l++) {
+                if (m[l] && stack_pointer[l] > 0)
+                    program_counter[l] = stack[--stack_pointer[l]][l];
+            }
+            return false;
+        case 0x0FB:
+        case 0x0FC:
+            for (size_t l=0; l<lanes; l++) {
+                if (m[l])
+                    scroll_sideways(l, NNN(inst) == 0x0FB);
+            }
+            break;
+        case 0x0FD:     // spins on the 00FD, like Chip8::exit_program
+            for (size_t l=0; l<lanes; l++) {
+                if (m[l])
+                    program_counter[l] -= 2;
+            }
+            return false;
+        case 0x0FF:     // hires - no room for it in a lane
+            for (size_t l=0; l<lanes; l++) {
+                if (m[l])
+                    halt(l);
+            }
+            return false;
+        default:
+            if ((NNN(inst) & 0xFF0) == 0x0C0 || (NNN(inst) & 0xFF0) == 0x0D0) {
+                for (size_t l=0; l<lanes; l++) {
+                    if (m[l])
+                        scroll_vertical(l, N(inst), (NNN(inst) & 0xFF0) == 0x0C0);
+                }
+            }
+            break;
+        }
+        break;
+    case 0x1:    set_16(program_counter.data(), NNN(inst), m, n);                    break;
+    case 0x2:
+        for (size_t l=0; l<lanes; l++) {
+            if (m[l] && stack_pointer[l] <= 15) {
+                stack[stack_pointer[l]++][l] = program_counter[l];
+                program_counter[l] = NNN(inst);
+            }
+        }
+        return false;
+    case 0x3:    skip_const(program_counter.data(), var_regs[x].data(), NN(inst), true, m, n);     return false;
+    case 0x4:    skip_const(program_counter.data(), var_regs[x].data(), NN(inst), false, m, n);    return false;
+    case 0x5:    skip_reg(program_counter.data(), var_regs[x].data(), var_regs[y].data(), true, m, n);   return false;
+    case 0x6:    set_const(var_regs[x].data(), NN(inst), m, n);                      break;
+    case 0x7:    add_const(var_regs[x].data(), NN(inst), m, n);                      break;
+    case 0x8:
+        alu(N(inst), var_regs[x].data(), var_regs[y].data(), var_regs[0xF].data(), shift_use_vy, m, n);
+        break;
+    case 0x9:    skip_reg(program_counter.data(), var_regs[x].data(), var_regs[y].data(), false, m, n);  return false;
+    case 0xA:    set_16(index_register.data(), NNN(inst), m, n);                     break;
+    case 0xB:
+        jump_offset(program_counter.data(), var_regs[jump_offset_vx ? x : 0].data(), NNN(inst), m, n);
+        return false;
+    case 0xC:    gen_rand(rng_state.data(), var_regs[x].data(), NN(inst), m, n);     break;
+    case 0xD:
+        for (size_t l=0; l<lanes; l++) {
+            if (m[l])
+                draw(l, x, y, N(inst));
+        }
+        break;
+    case 0xE:
+        switch (NN(inst)) {
+        case 0x9E:    skip_key(program_counter.data(), keys.data(), var_regs[x].data(), true, m, n);    return false;
+        case 0xA1:    skip_key(program_counter.data(), keys.data(), var_regs[x].data(), false, m, n);   return false;
+        }
+        break;
+    case 0xF:
+        switch (NN(inst)) {
+        case 0x01:      // FN01 - lanes only have plane 1, anything else stops the lane
+            if ((x & 3) != 1) {
+                for (size_t l=0; l<lanes; l++) {
+                    if (m[l])
+                        halt(l);
+                }
+                return false;
+            }
+            break;
+        case 0x07:    copy(var_regs[x].data(), delay_timer.data(), m, n);            break;
+        case 0x0A:
+            for (size_t l=0; l<lanes; l++) {
+                if (m[l])
+                    wait_key(l, x);
+            }
+            return false;
+        case 0x15:    copy(delay_timer.data(), var_regs[x].data(), m, n);            break;
+        case 0x18:    copy(sound_timer.data(), var_regs[x].data(), m, n);            break;
+        case 0x1E:    add_index(index_register.data(), var_regs[x].data(), m, n);    break;
+        case 0x29:    sprite_index(index_register.data(), var_regs[x].data(), m, n); break;
+        case 0x30:    big_sprite_index(index_register.data(), var_regs[x].data(), m, n); break;
+        case 0x33:
+            for (size_t l=0; l<lanes; l++) {
+                if (m[l])
+                    bcd(l, x);
+            }
+            break;
+        case 0x55:
+            for (size_t l=0; l<lanes; l++) {
+                if (m[l])
+                    reg_dump(l, x);
+            }
+            break;
+        case 0x65:
+            for (size_t l=0; l<lanes; l++) {
+                if (m[l])
+                    reg_load(l, x);
+            }
+            break;
+        }
+        break;
+    }
+
+    return true;
+}
+
+
+//////////////////////////////////////////////////
+//                Lane by Lane                  //
+//////////////////////////////////////////////////
+
+// addresses are wrapped to 12 bits so a lane never reaches its neighbour's
+// memory - Chip8 itself doesn't check I, so a ROM relying on either is broken
+
+// DXYN - see Chip8::draw
+void Lockstep::draw(size_t lane, uint8_t x, uint8_t y, uint8_t n) {
+    size_t x_coord = var_regs[x][lane] & 63;
+    size_t y_coord = var_regs[y][lane] & 31;
+    const uint8_t* mem = lane_memory(lane);
+    uint64_t* disp = lane_display(lane);
+    uint16_t index = index_register[lane];
+
+    // n = 0 is a 16x16 sprite, 2 bytes a row
+    size_t bytes = n ? 1 : 2;
+    size_t rows = n ? n : 16;
+
+    var_regs[0xF][lane] = 0;
+
+    if (y_coord + rows > 32)
+        rows = 32 - y_coord;
+
+    for (size_t i=0; i<rows; i++) {
+        uint64_t sprite_row = mem[(index + i*bytes) & 0xFFF];
+        if (bytes == 2)
+            sprite_row = (sprite_row << 8) | mem[(index + i*bytes + 1) & 0xFFF];
+        int shift = 64 - 8*int(bytes) - int(x_coord);
+        sprite_row = (shift >= 0) ? (sprite_row << shift) : (sprite_row >> -shift);
+
+        if (disp[y_coord+i] & sprite_row)
+            var_regs[0xF][lane] = 1;
+        disp[y_coord+i] ^= sprite_row;
+    }
+}
+
+// 00CN / 00DN - see Chip8::scroll_down / scroll_up, at 32 rows
+void Lockstep::scroll_vertical(size_t lane, uint8_t n, bool down) {
+    uint64_t* disp = lane_display(lane);
+    if (down) {
+        for (int r=31; r>=0; r--)
+            disp[r] = r >= n ? disp[r-n] : 0;
+    } else {
+        for (int r=0; r<32; r++)
+            disp[r] = r + n < 32 ? disp[r+n] : 0;
+    }
+}
+
+// 00FB / 00FC - 4 pixels, anything pushed past either edge is gone in lores
+void Lockstep::scroll_sideways(size_t lane, bool right) {
+    uint64_t* disp = lane_display(lane);
+    for (int r=0; r<32; r++)
+        disp[r] = right ? disp[r] >> 4 : disp[r] << 4;
+}
+
+// stop a lane on an instruction it can't run - back on it, with no budget
+void Lockstep::halt(size_t lane) {
+    unsupported[lane] = 1;
+    program_counter[lane] -= 2;
+    left[lane] = 0;
+    mask[lane] = 0;
+}
+
+// FX0A - same three step wait as instruction_cycle
+void Lockstep::wait_key(size_t lane, uint8_t x) {
+    switch (block_state[lane]) {
+    case 0:
+        block_state[lane] = 1;
+        program_counter[lane] -= 2;
+        break;
+    case 1:
+        if (last_key_down[lane] >= 0) {
+            var_regs[x][lane] = last_key_down[lane];
+            block_state[lane] = 2;
+        }
+        program_counter[lane] -= 2;
+        break;
+    case 2:
+        if (last_key_down[lane] == -1)
+            block_state[lane] = 0;
+        else
+            program_counter[lane] -= 2;
+        break;
+    }
+}
+
+// FX33
+void Lockstep::bcd(size_t lane, uint8_t x) {
+    uint8_t* mem = lane_memory(lane);
+    uint16_t index = index_register[lane];
+    uint8_t value = var_regs[x][lane];
+
+    mem[index & 0xFFF]       = value / 100;
+    mem[(index + 1) & 0xFFF] = (value % 100) / 10;
+    mem[(index + 2) & 0xFFF] = value % 10;
+
+    for (int i=0; i<3; i++)
+        written.set((index + i) & 0xFFF);
+}
+
+// FX55
+void Lockstep::reg_dump(size_t lane, uint8_t x) {
+    uint8_t* mem = lane_memory(lane);
+    uint16_t index = index_register[lane];
+
+    for (int i=0; i<=x; i++) {
+        mem[(index + i) & 0xFFF] = var_regs[i][lane];
+        written.set((index + i) & 0xFFF);
+    }
+
+    if (store_load_i_inc)
+        index_register[lane] += x + 1;
+}
+
+// FX65
+void Lockstep::reg_load(size_t lane, uint8_t x) {
+    const uint8_t* mem = lane_memory(lane);
+    uint16_t index = index_register[lane];
+
+    for (int i=0; i<=x; i++)
+        var_regs[i][lane] = mem[(index + i) & 0xFFF];
+
+    if (store_load_i_inc)
+        index_register[lane] += x + 1;
+}
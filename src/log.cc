@@ -0,0 +1,153 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "log.hh"
+
+thread_local ThreadLog* log_local = nullptr;
+
+namespace {
+
+// how long the drain thread sleeps when every ring was empty
+constexpr auto idle_wait = std::chrono::milliseconds(5);
+
+char const* level_name(LogLevel level) {
+    switch (level) {
+    case LogLevel::Trace:   return "trace";
+    case LogLevel::Debug:   return "debug";
+    case LogLevel::Info:    return "info";
+    case LogLevel::Warn:    return "warn";
+    case LogLevel::Error:   return "error";
+    }
+    return "?";
+}
+
+uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Owns every thread's ring (they outlive their threads, there are only ever a
+// few) & the thread that empties them. Started by the first message, stopped
+// & flushed at exit.
+class Drain {
+    std::mutex lock;    // logs - only taken to register a thread & to drain
+    std::vector<std::unique_ptr<ThreadLog>> logs;
+    std::vector<LogRecord> batch;
+    std::string line;
+    uint64_t start_ns;
+    std::atomic<bool> stop_requested;
+    std::thread thread;
+
+    void loop() {
+        while (!stop_requested.load(std::memory_order_relaxed)) {
+            if (!drain())
+                std::this_thread::sleep_for(idle_wait);
+        }
+    }
+
+    void format(const LogRecord& record) {
+        char prefix[48];
+        std::snprintf(prefix, sizeof(prefix), "[%12.6f] %-5s ",
+                      (record.time_ns - std::min(record.time_ns, start_ns)) / 1e9, level_name(record.level));
+        line = prefix;
+
+        int arg = 0;
+        for (char const* c = record.format; *c; c++) {
+            if (c[0] == '{' && c[1] == '}' && arg < record.arg_count) {
+                line += std::to_string(record.args[arg++]);
+                c++;
+            }
+            else {
+                line += *c;
+            }
+        }
+        line += '\n';
+        std::fwrite(line.data(), 1, line.size(), stderr);
+    }
+
+public:
+    Drain() : start_ns(now_ns()), stop_requested(false), thread(&Drain::loop, this) {}
+
+    ~Drain() {
+        stop_requested.store(true);
+        thread.join();
+        drain();
+    }
+
+    ThreadLog& add() {
+        std::lock_guard<std::mutex> guard(lock);
+        logs.push_back(std::make_unique<ThreadLog>());
+        return *logs.back();
+    }
+
+    // everything queued so far, oldest first across threads
+    // returns false if there was nothing
+    bool drain() {
+        std::lock_guard<std::mutex> guard(lock);
+        uint64_t dropped = 0;
+        batch.clear();
+        for (auto& log : logs) {
+            LogRecord record;
+            while (log->ring.pop(record))
+                batch.push_back(record);
+            dropped += log->dropped.exchange(0, std::memory_order_relaxed);
+        }
+        if (batch.empty() && dropped == 0)
+            return false;
+
+        std::stable_sort(batch.begin(), batch.end(),
+                         [](const LogRecord& a, const LogRecord& b) { return a.time_ns < b.time_ns; });
+        for (const LogRecord& record : batch)
+            format(record);
+        if (dropped)
+            std::fprintf(stderr, "[log] %llu messages dropped, ring full\n", (unsigned long long)dropped);
+        std::fflush(stderr);
+        return true;
+    }
+};
+
+Drain& drain_thread() {
+    static Drain drain;
+    return drain;
+}
+
+}
+
+ThreadLog& log_register() {
+    ThreadLog& log = drain_thread().add();
+    log_local = &log;
+    return log;
+}
@@ -26,183 +26,260 @@ freely, subject to the following restrictions:
    misrepresented as being the original software.
 3. This notice may not be removed or altered from any source distribution.
 */
-#include <filesystem>
-#include <sys/wait.h>
-#include <unistd.h>
+#include <array>
 #include <chrono>
-
-#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <string_view>
+#include <vector>
 
 #include "tinyfiledialogs.h"
 
 #include "window.hh"
+#include "audio.hh"
 #include "chip8.hh"
+#include "emu_thread.hh"
+#include "engine.hh"
+#include "expand.hh"
+#include "log.hh"
+#include "movie.hh"
+#include "romdb.hh"
+#include "stats.hh"
 
-// instruction decode macros
-#define OP(ins) ((ins & 0xF000) >> 12)
-#define X(ins) ((ins & 0x0F00) >> 8)
-#define Y(ins) ((ins & 0x00F0) >> 4)
-#define N(ins) (ins & 0x000F)
-#define NN(ins) (ins & 0x00FF)
-#define NNN(ins) (ins & 0x0FFF)
+// A ROM given on the command line means a scripted launch: no dialogs, and
+// errors go to stderr instead of a message box nobody may be there to close.
+static bool scripted = false;
 
-void instruction_cycle(Chip8&, WindowHandler&);
+static int fail(char const* message) {
+    if (scripted)
+        std::fprintf(stderr, "error: %s\n", message);
+    else
+        tinyfd_messageBox("Error", message, "ok", "error", 1);
+    return 1;
+}
+
+static char const* const usage =
+    "Usage: chip-8-cpp [rom.ch8] [--ips N] [--quirks vip|chip48|schip] [--engine switch|dispatch|jit] "
+    "[--speed N|max] [--turbo N|max] [--fg RRGGBB] [--bg RRGGBB] [--rewind-mb N] [--audio-buffer N] "
+    "[--record F] [--play F] [--stats F]";
+
+// "max" - uncapped (0), or a whole multiple of real time
+static bool parse_speed(std::string_view text, int& speed) {
+    if (text == "max") {
+        speed = 0;
+        return true;
+    }
+    speed = std::atoi(text.data());
+    return speed > 0;
+}
 
 int main(int argc, char ** argv) {
-    tinyfd_messageBox(
-        "Chip8c++",
-        "Please select a Chip 8 ROM to run",
-        "ok",
-        "option",
-        0
-    );
-    char const* filter_patterns[1] = {"*.ch8"};
-    char const* filepath = tinyfd_openFileDialog(
-        "Select ROM",
-        "./",
-        1,
-        filter_patterns,
-        "*.ch8",
-        0
-    );
-    if (!filepath) {
-        tinyfd_messageBox(
-			"Error",
-			"No ROM selected",
-			"ok",
-			"error",
-			1
-        );
-		return 1;
+    // rom: first argument that isn't an option - skips the dialogs
+    // speed & quirks: --ips N, --quirks vip | chip48 | schip, otherwise from
+    //   the ROM database if the ROM is in it
+    // execution strategy: --engine switch | dispatch | jit (default dispatch)
+    // speed: --speed N | max, a multiple of real time (default 1)
+    // fast-forward while tab is held: --turbo N | max (default max)
+    // optional colours: --fg RRGGBB --bg RRGGBB
+    // rewind history (hold backspace): --rewind-mb N, 0 to turn it off
+    // input movies: --record F, --play F (both turn rewind off)
+    // audio buffer: --audio-buffer N sample frames at 48 kHz (default 256, ~5 ms), 0 for no sound
+    // execution statistics (CHIP8_STATS builds): --stats F, written on exit & on SIGUSR1
+    Palette palette{};
+    int ips = 0;
+    int speed = 1;
+    int turbo = 0;
+    int rewind_mb = 16;
+    int audio_buffer = 256;
+    char const* rom_arg = nullptr;
+    char const* record_path = nullptr;
+    char const* play_path = nullptr;
+    char const* quirks_name = nullptr;
+    char const* stats_path = nullptr;
+    char const* engine_name = "dispatch";
+    QuirkProfile profile;
+    for (int i=1; i<argc; i++) {
+        std::string_view opt{argv[i]};
+        if (!opt.starts_with("-") && !rom_arg) {
+            rom_arg = argv[i];
+            continue;
+        }
+        bool ok = (i+1 >= argc) ? false
+                : (opt == "--ips") ? (ips = std::atoi(argv[i+1])) > 0
+                : (opt == "--speed") ? parse_speed(argv[i+1], speed)
+                : (opt == "--turbo") ? parse_speed(argv[i+1], turbo)
+                : (opt == "--fg") ? parse_color(argv[i+1], palette.fg)
+                : (opt == "--bg") ? parse_color(argv[i+1], palette.bg)
+                : (opt == "--rewind-mb") ? (rewind_mb = std::atoi(argv[i+1])) >= 0
+                : (opt == "--audio-buffer") ? (audio_buffer = std::atoi(argv[i+1])) >= 0
+                : (opt == "--record") ? (record_path = argv[i+1]) != nullptr
+                : (opt == "--play") ? (play_path = argv[i+1]) != nullptr
+                : (opt == "--quirks") ? parse_quirk_profile(quirks_name = argv[i+1], profile)
+                : (opt == "--engine") ? has_engine(engine_name = argv[i+1])
+                : (opt == "--stats") ? (stats_path = argv[i+1]) != nullptr
+                : false;
+        if (!ok) {
+            scripted = true;
+            return fail(usage);
+        }
+        i++;
     }
+    scripted = (rom_arg != nullptr);
 
+    // before SDL or the emulation thread start, so they leave SIGUSR1 to the dumper
+    stats_install(stats_path);
 
-    std::filesystem::path rom{filepath};
-    if (!std::filesystem::exists(rom) || rom.extension() != ".ch8") {
+    std::filesystem::path rom;
+    if (rom_arg) {
+        rom = rom_arg;
+        if (!std::filesystem::is_regular_file(rom))
+            return fail("The ROM file does not exist.");
+    }
+    else {
         tinyfd_messageBox(
-			"Error",
-			"Invalid file! Select a valid Chip 8 ROM file. (.ch8)",
-			"ok",
-			"error",
-			1
+            "Chip8c++",
+            "Please select a Chip 8 ROM to run",
+            "ok",
+            "option",
+            0
+        );
+        char const* filter_patterns[1] = {"*.ch8"};
+        char const* filepath = tinyfd_openFileDialog(
+            "Select ROM",
+            "./",
+            1,
+            filter_patterns,
+            "*.ch8",
+            0
         );
-		return 1;
+        if (!filepath)
+            return fail("No ROM selected");
+
+        rom = filepath;
+        if (!std::filesystem::exists(rom) || rom.extension() != ".ch8")
+            return fail("Invalid file! Select a valid Chip 8 ROM file. (.ch8)");
     }
-    
 
-    Chip8 chip8(filepath);
-    WindowHandler w{};
+    std::vector<uint8_t> rom_bytes = read_rom_file(rom);
+    Chip8 chip8(rom_bytes);
 
-    std::chrono::time_point time_next = std::chrono::high_resolution_clock::now();
-    std::chrono::nanoseconds inst_time{1000000000 / chip8.get_timing()};
-
-    while (w.get_run_status()) {
-        w.poll_events();
-        
-        // std::array<bool, 16> keys = w.get_keys();
-        // for (bool key : keys) {
-        //     std::cout << key << " ";
-        // }
-        // std::cout << "\n";
-
-        if (std::chrono::high_resolution_clock::now() >= time_next) {
-            instruction_cycle(chip8, w);
-            time_next += inst_time;
-        }
+    // flags first, then the database
+    const RomInfo* known = rom_lookup(rom_hash(rom_bytes));
+    if (known)
+        CHIP8_LOG(Info, "ROM found in the database: ips {}, quirks {}", known->ips, known->quirks);
+
+    if (ips > 0)
+        chip8.config_timing(ips);
+    else if (known && known->ips > 0)
+        chip8.config_timing(known->ips);
+
+    if (quirks_name)
+        chip8.config_quirks(profile);
+    else if (known && known->quirks >= 0)
+        chip8.config_quirk_bits(known->quirks);
+
+    // a movie replays from its own seed & configuration, otherwise seed from the clock
+    MovieReader player;
+    MovieWriter recorder;
+    uint64_t seed = time(NULL);
+    if (play_path) {
+        if (player.open(play_path) || start_movie(chip8, player.get_header()))
+            return fail("Could not play the movie - unreadable, or recorded with a different ROM.");
+        seed = player.get_header().seed;
+    }
+    else {
+        chip8.seed_rand(seed);
     }
-    
-    return 0;
-}
 
+    if (record_path && recorder.open(record_path, make_movie_header(chip8, seed)))
+        return fail("Could not create the movie file.");
 
-void instruction_cycle(Chip8& chip8, WindowHandler& w) {
-    uint16_t inst = chip8.get_inst();
-    switch (OP(inst)) {
-    case 0x0:
-        switch (NNN(inst)) {
-        case 0x0E0:    chip8.disp_clear();                               break;
-        case 0x0EE:    chip8.subroutine_return();                        break;
-        }
-        break;
-    case 0x1:    chip8.jump(NNN(inst));                                  break;
-    case 0x2:    chip8.subroutine_call(NNN(inst));                       break;
-    case 0x3:    chip8.skip_equal_const(X(inst), NN(inst));              break;
-    case 0x4:    chip8.skip_not_equal_const(X(inst), NN(inst));          break;
-    case 0x5:    chip8.skip_equal(X(inst), Y(inst));                     break;
-    case 0x6:    chip8.set_reg_const(X(inst), NN(inst));                 break;
-    case 0x7:    chip8.add_reg_const(X(inst), NN(inst));                 break;
-    case 0x8:
-        switch (N(inst)) {
-        case 0x0:    chip8.set_reg(X(inst), Y(inst));                    break;
-        case 0x1:    chip8.bitwise_or(X(inst), Y(inst));                 break;
-        case 0x2:    chip8.bitwise_and(X(inst), Y(inst));                break;
-        case 0x3:    chip8.bitwise_xor(X(inst), Y(inst));                break;
-        case 0x4:    chip8.add(X(inst), Y(inst));                        break;
-        case 0x5:    chip8.subtract_x_y(X(inst), Y(inst));               break;
-        case 0x6:    chip8.bitwise_shift_right(X(inst), Y(inst));        break;
-        case 0x7:    chip8.subtract_y_x(X(inst), Y(inst));               break;
-        case 0xE:    chip8.bitwise_shift_left(X(inst), Y(inst));         break;
-        }
-        break;
-    case 0x9:    chip8.skip_not_equal(X(inst), Y(inst));                 break;
-    case 0xA:    chip8.set_index(NNN(inst));                             break;
-    case 0xB:    chip8.jump_offset(NNN(inst));                           break;
-    case 0xC:    chip8.gen_rand(X(inst), NN(inst));                      break;
-    case 0xD:    chip8.draw(X(inst), Y(inst), N(inst));                  break;
-    case 0xE:
-        switch (NN(inst)) {
-        case 0x9E:
-            if (w.keys[chip8.get_var_reg(X(inst))])
-                chip8.increment_pc();
-            break;
-        case 0xA1:
-            if (!w.keys[chip8.get_var_reg(X(inst))])
-                chip8.increment_pc();
-            break;
+    // stepping back would desync a movie
+    if (record_path || play_path)
+        rewind_mb = 0;
+
+    WindowHandler w{};
+    w.set_palette(palette);
+
+    // no audio device - silent, not an error
+    AudioOutput audio(audio_buffer);
+
+    // emulation runs on its own thread, this one just handles events & presents
+    EmuThread emu(chip8, w, engine_name, size_t(rewind_mb) << 20,
+                  record_path ? &recorder : nullptr, play_path ? &player : nullptr, audio.get_beeper(),
+                  &w.get_input_queue());
+
+    Screen frame{};
+    Screen shown{};
+    bool first_frame = true;
+    LatencyStats latency;
+
+    // speed reached, measured over half second windows
+    auto speed_start = std::chrono::steady_clock::now();
+    uint64_t speed_frames = 0;
+
+    while (w.get_run_status() && emu.is_running()) {
+        w.wait_events(1);
+        emu.set_rewinding(w.rewind_is_held());
+
+        int requested = w.turbo_is_held() ? turbo : speed;
+        emu.set_speed(requested);
+
+        std::chrono::duration<double> window = std::chrono::steady_clock::now() - speed_start;
+        if (window.count() >= 0.5) {
+            uint64_t frames = emu.get_frame_count();
+            double multiple = (frames - speed_frames) / 60.0 / window.count();
+            speed_start += std::chrono::duration_cast<std::chrono::steady_clock::duration>(window);
+            speed_frames = frames;
+
+            char title[64];
+            if (requested == 1)
+                std::snprintf(title, sizeof(title), "Chip8");
+            else
+                std::snprintf(title, sizeof(title), "Chip8 - %.1fx", multiple);
+            w.set_title(title);
         }
-        break;
-    case 0xF:
-        switch (NN(inst)) {
-        case 0x07:    chip8.get_delay(X(inst));                          break;
-        case 0x0A:
-            switch (chip8.block_state) {
-            case 0:
-                chip8.block_state = 1;
-                chip8.decrement_pc();
-                break;
-            case 1:
-                if (w.last_key_down >= 0 && w.keys[w.last_key_down]) {
-                    chip8.set_reg_const(X(inst), w.last_key_down);
-                    std::cout << "REG " << X(inst) << " - " << int(chip8.get_var_reg(X(inst))) << "\n";
-                    chip8.block_state = 2;
-                }
-                chip8.decrement_pc();
-                break;
-            case 2:
-                if (w.last_key_down == -1) {
-                    chip8.block_state = 0;
-                    std::cout << "(end)REG " << X(inst) << " - " << int(chip8.get_var_reg(X(inst))) << "\n";
-                }
-                else {
-                    chip8.decrement_pc();
-                }
-                break;
+
+        uint64_t input_ns;
+        if (emu.take_frame(frame, input_ns)) {
+            uint64_t dirty_rows = 0;
+            for (int y=0; y<frame.height(); y++) {
+                if (first_frame || frame.hires != shown.hires
+                        || frame.planes[0][y] != shown.planes[0][y] || frame.planes[1][y] != shown.planes[1][y])
+                    dirty_rows |= uint64_t(1) << y;
             }
-            break;
-        case 0x15:    chip8.set_delay(X(inst));                          break;
-        case 0x18:    chip8.set_sound(X(inst));                          break;
-        case 0x1E:    chip8.add_index(X(inst));                          break;
-        case 0x29:    chip8.sprite_index(X(inst));                       break;
-        case 0x33:    chip8.bcd(X(inst));                                break;
-        case 0x55:    chip8.reg_dump(X(inst));                           break;
-        case 0x65:    chip8.reg_load(X(inst));                           break;
+            first_frame = false;
+            shown = frame;
+
+            if (dirty_rows)
+                w.draw_pixels(frame, dirty_rows);
+
+            // key press to the frame it changed being presented
+            if (input_ns)
+                latency.add(input_clock_ns() - input_ns);
         }
-        break;
     }
+    emu.stop();
 
-    if (OP(inst) == 0xD || inst == 0x00E0)
-        w.draw_pixels(chip8.get_display());
+    if (latency.get_count()) {
+        CHIP8_LOG(Info, "input latency over {} presses: min {} us, mean {} us, max {} us",
+                  latency.get_count(), latency.get_min_ns() / 1000,
+                  latency.get_mean_ns() / 1000, latency.get_max_ns() / 1000);
+    }
 
-    if (chip8.end_of_mem())
+    if (record_path && recorder.close()) {
+        if (scripted)
+            return fail("Could not write the whole movie file.");
+        w.popup("Error", "Could not write the whole movie file.");
+    }
+
+    if (emu.end_of_mem()) {
+        if (scripted)
+            return fail("The program counter is pointing past end of the memory.");
         w.popup("End of memory", "The program counter is pointing past end of the memory.");
+    }
+
+    return 0;
 }
\ No newline at end of file
@@ -0,0 +1,219 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <span>
+
+#include "movie.hh"
+#include "romdb.hh"
+#include "savestate.hh"
+
+//////////////////////////////////////////////////
+//                    Header                    //
+//////////////////////////////////////////////////
+
+MovieHeader make_movie_header(Chip8& chip8, uint64_t seed) {
+    SaveState state;
+    chip8.save(state);
+
+    MovieHeader header{};
+    header.magic = MovieHeader::magic_value;
+    header.version = MovieHeader::current_version;
+    header.seed = seed;
+    header.rom_hash = rom_hash(std::span{state.memory}.subspan(0x200));
+    header.inst_per_sec = state.inst_per_sec;
+    header.shift_use_vy = state.shift_use_vy;
+    header.jump_offset_vx = state.jump_offset_vx;
+    header.store_load_i_inc = state.store_load_i_inc;
+    return header;
+}
+
+int start_movie(Chip8& chip8, const MovieHeader& header) {
+    SaveState state;
+    chip8.save(state);
+    if (rom_hash(std::span{state.memory}.subspan(0x200)) != header.rom_hash)
+        return 1;
+
+    chip8.config_timing(header.inst_per_sec);
+    chip8.config_shift(header.shift_use_vy);
+    chip8.config_jump_offset(header.jump_offset_vx);
+    chip8.config_store_load_inc(header.store_load_i_inc);
+    chip8.seed_rand(header.seed);
+    return 0;
+}
+
+
+//////////////////////////////////////////////////
+//                    Writer                    //
+//////////////////////////////////////////////////
+
+MovieWriter::MovieWriter() {
+    out = nullptr;
+    run_keys = 0;
+    run_length = 0;
+    frames = 0;
+    failed = false;
+}
+
+MovieWriter::~MovieWriter() {
+    close();
+}
+
+int MovieWriter::open(const std::filesystem::path& path, const MovieHeader& header) {
+    close();
+
+    out = std::fopen(path.c_str(), "wb");
+    if (!out)
+        return 1;
+
+    run_length = 0;
+    frames = 0;
+    failed = std::fwrite(&header, sizeof(MovieHeader), 1, out) != 1;
+    return failed ? 1 : 0;
+}
+
+void MovieWriter::record(uint16_t keys) {
+    if (!out)
+        return;
+
+    if (run_length > 0 && keys != run_keys)
+        write_run();
+
+    run_keys = keys;
+    run_length++;
+    frames++;
+}
+
+void MovieWriter::write_run() {
+    uint8_t bytes[12];
+    size_t len = 0;
+
+    uint64_t count = run_length;
+    do {
+        bytes[len++] = (count & 0x7F) | (count > 0x7F ? 0x80 : 0);
+        count >>= 7;
+    } while (count);
+
+    bytes[len++] = run_keys & 0xFF;
+    bytes[len++] = run_keys >> 8;
+
+    if (std::fwrite(bytes, 1, len, out) != len)
+        failed = true;
+    run_length = 0;
+}
+
+int MovieWriter::close() {
+    if (!out)
+        return 0;
+
+    if (run_length > 0)
+        write_run();
+    if (std::fclose(out) != 0)
+        failed = true;
+    out = nullptr;
+
+    return failed ? 1 : 0;
+}
+
+uint64_t MovieWriter::get_frames() {
+    return frames;
+}
+
+
+//////////////////////////////////////////////////
+//                    Reader                    //
+//////////////////////////////////////////////////
+
+MovieReader::MovieReader() {
+    in = nullptr;
+    header = {};
+    run_keys = 0;
+    run_left = 0;
+}
+
+MovieReader::~MovieReader() {
+    if (in)
+        std::fclose(in);
+}
+
+int MovieReader::open(const std::filesystem::path& path) {
+    if (in)
+        std::fclose(in);
+    run_left = 0;
+
+    in = std::fopen(path.c_str(), "rb");
+    if (!in)
+        return 1;
+
+    if (std::fread(&header, sizeof(MovieHeader), 1, in) != 1
+        || header.magic != MovieHeader::magic_value
+        || header.version != MovieHeader::current_version)
+    {
+        std::fclose(in);
+        in = nullptr;
+        return 1;
+    }
+
+    return 0;
+}
+
+const MovieHeader& MovieReader::get_header() {
+    return header;
+}
+
+bool MovieReader::next(uint16_t& keys) {
+    // a truncated run just ends the movie early
+    while (run_left == 0) {
+        if (!in)
+            return false;
+
+        uint64_t count = 0;
+        int c;
+        for (int shift=0; shift<64; shift+=7) {
+            if ((c = std::fgetc(in)) == EOF)
+                break;
+            count |= uint64_t(c & 0x7F) << shift;
+            if (!(c & 0x80))
+                break;
+        }
+
+        int lo = std::fgetc(in);
+        int hi = std::fgetc(in);
+        if (c == EOF || (c & 0x80) || lo == EOF || hi == EOF) {
+            std::fclose(in);
+            in = nullptr;
+            return false;
+        }
+
+        run_keys = uint16_t(lo | (hi << 8));
+        run_left = count;
+    }
+
+    run_left--;
+    keys = run_keys;
+    return true;
+}
@@ -0,0 +1,199 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+#include "interpreter.hh"
+#include "profiler.hh"
+
+namespace {
+
+// hottest addresses listed in the flat profile
+constexpr size_t hotspot_count = 32;
+
+std::string routine_name(uint16_t routine, uint16_t root) {
+    if (routine == root)
+        return "main";
+    char name[16];
+    std::snprintf(name, sizeof(name), "sub_%03X", routine);
+    return name;
+}
+
+double percent(uint64_t part, uint64_t whole) {
+    return whole ? 100.0 * part / whole : 0.0;
+}
+
+}
+
+Profiler::Profiler(Chip8& chip8, Frontend& io) : chip8(chip8), io(io) {
+    nodes.push_back(Node{root, -1, 0});
+    current = 0;
+    hits.fill(0);
+    owner.fill(root);
+    total = 0;
+    chip8.watch_calls(this);
+}
+
+Profiler::~Profiler() {
+    chip8.watch_calls(nullptr);
+}
+
+uint64_t Profiler::run(uint64_t n) {
+    uint64_t executed = 0;
+    while (executed < n) {
+        uint16_t pc = chip8.get_pc() & 0xFFF;
+        hits[pc]++;
+        owner[pc] = nodes[current].routine;
+        nodes[current].count++;
+        total++;
+
+        executed++;
+        if (instruction_cycle(chip8, io))
+            break;
+    }
+    return executed;
+}
+
+void Profiler::on_call(uint16_t, uint16_t to) {
+    edges[{nodes[current].routine, to}]++;
+
+    uint64_t key = (uint64_t(current) << 16) | to;
+    auto [child, inserted] = children.try_emplace(key, int32_t(nodes.size()));
+    if (inserted)
+        nodes.push_back(Node{to, current, 0});
+    current = child->second;
+}
+
+// a return with nothing on the rebuilt stack (the profiler took over inside a
+// subroutine) just stays in main
+void Profiler::on_return(uint16_t) {
+    if (nodes[current].parent >= 0)
+        current = nodes[current].parent;
+}
+
+// routines from main down to node
+std::vector<uint16_t> Profiler::stack_of(int32_t node) {
+    std::vector<uint16_t> stack;
+    for (; node >= 0; node = nodes[node].parent)
+        stack.push_back(nodes[node].routine);
+    std::reverse(stack.begin(), stack.end());
+    return stack;
+}
+
+
+//////////////////////////////////////////////////
+//                   Reports                    //
+//////////////////////////////////////////////////
+
+int Profiler::write_flat(const std::filesystem::path& path) {
+    struct Routine {
+        uint64_t self = 0;
+        uint64_t total = 0;     // self + everything called from it, recursion counted once
+        uint64_t calls = 0;
+    };
+    std::map<uint16_t, Routine> routines;
+
+    for (int32_t i=0; i<int32_t(nodes.size()); i++) {
+        std::vector<uint16_t> stack = stack_of(i);
+        routines[nodes[i].routine].self += nodes[i].count;
+
+        std::sort(stack.begin(), stack.end());
+        stack.erase(std::unique(stack.begin(), stack.end()), stack.end());
+        for (uint16_t routine : stack)
+            routines[routine].total += nodes[i].count;
+    }
+    for (auto& [edge, calls] : edges)
+        routines[edge.second].calls += calls;
+
+    std::FILE* out = std::fopen(path.c_str(), "w");
+    if (!out)
+        return 1;
+
+    std::vector<std::pair<uint16_t, Routine>> by_self(routines.begin(), routines.end());
+    std::stable_sort(by_self.begin(), by_self.end(),
+                     [](const auto& a, const auto& b) { return a.second.self > b.second.self; });
+
+    std::fprintf(out, "Flat profile - %llu instructions\n\n", (unsigned long long)total);
+    std::fprintf(out, "%12s %6s %12s %6s %10s  %s\n", "self", "self%", "total", "total%", "calls", "routine");
+    for (auto& [routine, r] : by_self) {
+        std::fprintf(out, "%12llu %6.2f %12llu %6.2f %10llu  %s\n",
+                     (unsigned long long)r.self, percent(r.self, total),
+                     (unsigned long long)r.total, percent(r.total, total),
+                     (unsigned long long)r.calls, routine_name(routine, root).c_str());
+    }
+
+    std::fprintf(out, "\nCall graph\n\n%10s  %s\n", "calls", "caller -> callee");
+    for (auto& [edge, calls] : edges) {
+        std::fprintf(out, "%10llu  %s -> %s\n", (unsigned long long)calls,
+                     routine_name(edge.first, root).c_str(), routine_name(edge.second, root).c_str());
+    }
+
+    // busiest addresses, with the instruction there now
+    std::vector<uint16_t> hot;
+    for (uint16_t addr=0; addr<hits.size(); addr++) {
+        if (hits[addr])
+            hot.push_back(addr);
+    }
+    size_t shown = std::min(hot.size(), hotspot_count);
+    std::partial_sort(hot.begin(), hot.begin() + shown, hot.end(),
+                      [&](uint16_t a, uint16_t b) { return hits[a] != hits[b] ? hits[a] > hits[b] : a < b; });
+
+    std::fprintf(out, "\nHotspots\n\n%5s  %4s %12s %6s  %s\n", "addr", "inst", "count", "%", "routine");
+    for (size_t i=0; i<shown; i++) {
+        uint16_t addr = hot[i];
+        std::fprintf(out, "0x%03X  %02X%02X %12llu %6.2f  %s\n", addr,
+                     chip8.memory[addr], chip8.memory[(addr + 1) & 0xFFF],
+                     (unsigned long long)hits[addr], percent(hits[addr], total),
+                     routine_name(owner[addr], root).c_str());
+    }
+
+    return std::fclose(out) == 0 ? 0 : 1;
+}
+
+int Profiler::write_folded(const std::filesystem::path& path) {
+    std::FILE* out = std::fopen(path.c_str(), "w");
+    if (!out)
+        return 1;
+
+    for (int32_t i=0; i<int32_t(nodes.size()); i++) {
+        if (nodes[i].count == 0)
+            continue;
+
+        std::string line;
+        for (uint16_t routine : stack_of(i)) {
+            if (!line.empty())
+                line += ';';
+            line += routine_name(routine, root);
+        }
+        std::fprintf(out, "%s %llu\n", line.c_str(), (unsigned long long)nodes[i].count);
+    }
+
+    return std::fclose(out) == 0 ? 0 : 1;
+}
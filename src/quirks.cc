@@ -0,0 +1,50 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include "quirks.hh"
+
+bool parse_quirk_profile(std::string_view name, QuirkProfile& profile) {
+    if (name == "vip")
+        profile = QuirkProfile::VIP;
+    else if (name == "chip48")
+        profile = QuirkProfile::Chip48;
+    else if (name == "schip")
+        profile = QuirkProfile::SuperChip;
+    else
+        return false;
+    return true;
+}
+
+uint8_t quirk_profile_bits(QuirkProfile profile) {
+    switch (profile) {
+    case QuirkProfile::VIP:         return QuirksVIP::bits;
+    case QuirkProfile::Chip48:      return QuirksChip48::bits;
+    case QuirkProfile::SuperChip:   return QuirksSuperChip::bits;
+    }
+    return QuirksDefault::bits;
+}
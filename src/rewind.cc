@@ -0,0 +1,193 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <algorithm>
+#include <cstring>
+
+#include "rewind.hh"
+
+// record layout in the ring:  [u32 len] [len bytes of delta] [u32 len]
+// (the length at both ends lets the ring be walked from either side)
+//
+// delta encoding - repeated until the state is covered:
+//     varint zero_run, varint literal_len, literal_len bytes
+// where the bytes are old_state ^ new_state
+
+namespace {
+
+void put_varint(std::vector<uint8_t>& out, size_t v) {
+    while (v >= 0x80) {
+        out.push_back(uint8_t(v) | 0x80);
+        v >>= 7;
+    }
+    out.push_back(uint8_t(v));
+}
+
+size_t get_varint(const uint8_t*& in) {
+    size_t v = 0;
+    int shift = 0;
+    while (*in & 0x80) {
+        v |= size_t(*in++ & 0x7F) << shift;
+        shift += 7;
+    }
+    v |= size_t(*in++) << shift;
+    return v;
+}
+
+// XOR a & b, squeeze out the zero runs
+void encode_delta(const uint8_t* a, const uint8_t* b, size_t size, std::vector<uint8_t>& out) {
+    size_t pos = 0;
+    while (pos < size) {
+        size_t zero_start = pos;
+        while (pos < size && a[pos] == b[pos])
+            pos++;
+        if (pos == size)
+            break;
+
+        size_t lit_start = pos;
+        // a literal run ends at the first pair of equal bytes, so a single
+        // unchanged byte in the middle of a change doesn't split it
+        while (pos < size && (a[pos] != b[pos] || (pos + 1 < size && a[pos+1] != b[pos+1])))
+            pos++;
+
+        put_varint(out, lit_start - zero_start);
+        put_varint(out, pos - lit_start);
+        for (size_t i=lit_start; i<pos; i++)
+            out.push_back(a[i] ^ b[i]);
+    }
+}
+
+// state ^= delta
+void apply_delta(const uint8_t* in, const uint8_t* end, uint8_t* state) {
+    while (in < end) {
+        state += get_varint(in);
+        size_t lit = get_varint(in);
+        for (size_t i=0; i<lit; i++)
+            *(state++) ^= *(in++);
+    }
+}
+
+}
+
+Rewind::Rewind(size_t budget) : ring(std::max<size_t>(budget, 64)) {
+    clear();
+}
+
+void Rewind::clear() {
+    head = 0;
+    tail = 0;
+    used = 0;
+    count = 0;
+    have_newest = false;
+}
+
+size_t Rewind::frames() {
+    return count;
+}
+
+size_t Rewind::bytes_used() {
+    return used + (have_newest ? sizeof(SaveState) : 0);
+}
+
+void Rewind::push(const SaveState& state) {
+    if (!have_newest) {
+        newest = state;
+        have_newest = true;
+        return;
+    }
+
+    scratch.clear();
+    encode_delta(reinterpret_cast<const uint8_t*>(&newest), reinterpret_cast<const uint8_t*>(&state),
+                 sizeof(SaveState), scratch);
+    newest = state;
+
+    uint32_t len = scratch.size();
+    size_t record = len + 2 * sizeof(uint32_t);
+    if (record > ring.size()) {
+        // can't hold even one step, history restarts from here
+        head = tail = used = count = 0;
+        return;
+    }
+
+    while (ring.size() - used < record)
+        drop_oldest();
+
+    ring_write(reinterpret_cast<const uint8_t*>(&len), sizeof(len));
+    ring_write(scratch.data(), len);
+    ring_write(reinterpret_cast<const uint8_t*>(&len), sizeof(len));
+    used += record;
+    count++;
+}
+
+bool Rewind::step_back(SaveState& out) {
+    if (count == 0)
+        return false;
+
+    size_t size = ring.size();
+    uint32_t len = ring_read_u32((head + size - sizeof(uint32_t)) % size);
+    size_t record = len + 2 * sizeof(uint32_t);
+    size_t start = (head + size - record) % size;
+
+    scratch.resize(len);
+    ring_read((start + sizeof(uint32_t)) % size, scratch.data(), len);
+    apply_delta(scratch.data(), scratch.data() + len, reinterpret_cast<uint8_t*>(&newest));
+
+    head = start;
+    used -= record;
+    count--;
+
+    out = newest;
+    return true;
+}
+
+void Rewind::drop_oldest() {
+    uint32_t len = ring_read_u32(tail);
+    size_t record = len + 2 * sizeof(uint32_t);
+    tail = (tail + record) % ring.size();
+    used -= record;
+    count--;
+}
+
+void Rewind::ring_write(const uint8_t* data, size_t len) {
+    size_t first = std::min(len, ring.size() - head);
+    std::memcpy(&ring[head], data, first);
+    std::memcpy(&ring[0], data + first, len - first);
+    head = (head + len) % ring.size();
+}
+
+void Rewind::ring_read(size_t pos, uint8_t* data, size_t len) {
+    size_t first = std::min(len, ring.size() - pos);
+    std::memcpy(data, &ring[pos], first);
+    std::memcpy(data + first, &ring[0], len - first);
+}
+
+uint32_t Rewind::ring_read_u32(size_t pos) {
+    uint32_t v;
+    ring_read(pos, reinterpret_cast<uint8_t*>(&v), sizeof(v));
+    return v;
+}
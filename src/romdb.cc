@@ -0,0 +1,72 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include "romdb.hh"
+
+#include <algorithm>
+#include <array>
+
+namespace {
+
+// One line per ROM, in hash order (checked below). `chip8-headless rom.ch8
+// --rom-info [--ips N] [--quirks P]` prints the line for a ROM file - hashes
+// have to come from the actual files, never typed in by hand.
+constexpr std::array<RomInfo, 0> known_roms = {{
+}};
+
+constexpr bool is_sorted_unique() {
+    for (size_t i=1; i<known_roms.size(); i++) {
+        if (known_roms[i-1].hash >= known_roms[i].hash)
+            return false;
+    }
+    return true;
+}
+static_assert(is_sorted_unique(), "known_roms must be sorted by hash, one entry per ROM");
+
+}
+
+uint64_t rom_hash(std::span<const uint8_t> rom) {
+    uint64_t hash = 0xCBF29CE484222325;
+    for (uint8_t byte : rom) {
+        hash ^= byte;
+        hash *= 0x100000001B3;
+    }
+    return hash;
+}
+
+const RomInfo* rom_lookup(uint64_t hash) {
+    auto it = std::lower_bound(known_roms.begin(), known_roms.end(), hash,
+                               [](const RomInfo& info, uint64_t h) { return info.hash < h; });
+    if (it == known_roms.end() || it->hash != hash)
+        return nullptr;
+    return &*it;
+}
+
+std::span<const RomInfo> rom_database() {
+    return known_roms;
+}
@@ -0,0 +1,59 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <cstdio>
+
+#include "savestate.hh"
+
+int write_state_file(const std::filesystem::path& path, const SaveState& state) {
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out)
+        return 1;
+
+    size_t written = std::fwrite(&state, sizeof(SaveState), 1, out);
+    if (std::fclose(out) != 0 || written != 1)
+        return 1;
+
+    return 0;
+}
+
+int read_state_file(const std::filesystem::path& path, SaveState& state) {
+    std::FILE* in = std::fopen(path.c_str(), "rb");
+    if (!in)
+        return 1;
+
+    size_t read = std::fread(&state, sizeof(SaveState), 1, in);
+    std::fclose(in);
+    if (read != 1)
+        return 1;
+
+    if (state.magic != SaveState::magic_value || state.version != SaveState::current_version)
+        return 1;
+
+    return 0;
+}
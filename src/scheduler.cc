@@ -0,0 +1,120 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <algorithm>
+#include <thread>
+
+#include "scheduler.hh"
+#include "stats.hh"
+
+Scheduler::Scheduler(Chip8& chip8, Engine& engine, Frontend& io) : chip8(chip8), engine(engine), io(io) {
+    frame_time = std::chrono::nanoseconds{1000000000 / frame_rate};
+    next_frame = std::chrono::steady_clock::now() + frame_time;
+    speed = 1;
+    frame_count = 0;
+}
+
+// spread inst_per_sec over the frames of each second without drift,
+// e.g. 700 ips -> 11 or 12 instructions a frame
+uint64_t Scheduler::get_budget() {
+    uint64_t ips = chip8.get_timing();
+    uint64_t second_frame = frame_count % frame_rate;
+    return (second_frame + 1) * ips / frame_rate - second_frame * ips / frame_rate;
+}
+
+uint64_t Scheduler::run_frame() {
+    return run_steps({}, nullptr);
+}
+
+uint64_t Scheduler::run_frame(std::span<const KeyStep> steps, HeadlessFrontend& keypad) {
+    return run_steps(steps, &keypad);
+}
+
+uint64_t Scheduler::run_steps(std::span<const KeyStep> steps, HeadlessFrontend* keypad) {
+#ifdef CHIP8_STATS
+    auto start = std::chrono::steady_clock::now();
+#endif
+    uint64_t budget = get_budget();
+
+    // the burst is split wherever the keypad changes
+    uint64_t executed = 0;
+    bool stopped = false;
+    for (const KeyStep& step : steps) {
+        if (step.offset > executed)
+            executed += engine.run(std::min(step.offset, budget) - executed);
+        if (chip8.end_of_mem()) {
+            stopped = true;
+            break;
+        }
+        keypad->set_keys(step.keys);
+    }
+    if (!stopped && executed < budget)
+        executed += engine.run(budget - executed);
+    chip8.tick_timers();
+    frame_count++;
+
+    // however many sprites were drawn, the frontend hears about it once
+    uint64_t dirty_rows = chip8.take_dirty_rows();
+    if (dirty_rows)
+        io.draw_pixels(chip8.get_display(), dirty_rows);
+
+#ifdef CHIP8_STATS
+    CHIP8_STAT_FRAME(std::chrono::nanoseconds(std::chrono::steady_clock::now() - start).count());
+#endif
+    return executed;
+}
+
+void Scheduler::wait_frame() {
+    auto now = std::chrono::steady_clock::now();
+
+    // uncapped - pacing starts over from wherever it is when a speed is set
+    if (speed == 0) {
+        next_frame = now;
+        return;
+    }
+
+    std::chrono::nanoseconds step = frame_time / speed;
+    if (now - next_frame > 4 * step)
+        next_frame = now;
+    else
+        std::this_thread::sleep_until(next_frame);
+
+    next_frame += step;
+}
+
+void Scheduler::set_speed(int multiple) {
+    speed = std::max(multiple, 0);
+}
+
+int Scheduler::get_speed() {
+    return speed;
+}
+
+uint64_t Scheduler::get_frame_count() {
+    return frame_count;
+}
@@ -0,0 +1,202 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <bit>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+
+#include "stats.hh"
+
+thread_local StatCounters* stat_local = nullptr;
+
+namespace {
+
+std::mutex registry_lock;
+std::vector<StatCounters*> live;    // counters of every running thread that has counted
+StatCounters retired{};             // totals of threads that have exited
+std::string dump_path;
+
+void add_into(StatCounters& total, const StatCounters& counters) {
+    auto add = [](std::atomic<uint64_t>& to, const std::atomic<uint64_t>& from) {
+        stat_add(to, from.load(std::memory_order_relaxed));
+    };
+
+    for (int i=0; i<256; i++)
+        add(total.ops[i], counters.ops[i]);
+    add(total.draws, counters.draws);
+    add(total.collisions, counters.collisions);
+    stat_max(total.max_stack_depth, counters.max_stack_depth.load(std::memory_order_relaxed));
+    add(total.frames, counters.frames);
+    for (int i=0; i<StatCounters::frame_buckets; i++)
+        add(total.frame_us[i], counters.frame_us[i]);
+}
+
+// a thread's counters - folded into retired when the thread exits
+struct ThreadCounters {
+    StatCounters counters{};
+
+    ThreadCounters() {
+        std::lock_guard<std::mutex> guard(registry_lock);
+        live.push_back(&counters);
+    }
+
+    ~ThreadCounters() {
+        std::lock_guard<std::mutex> guard(registry_lock);
+        add_into(retired, counters);
+        std::erase(live, &counters);
+        stat_local = nullptr;
+    }
+};
+
+// the name of each used stat_slot(), nullptr for unused slots
+char const* slot_name(uint8_t slot) {
+    static char const* const family_0[] = {"00E0", "00EE", "0NNN", "00CN", "00DN", "00FB", "00FC", "00FD",
+                                           "00FE", "00FF"};
+    static char const* const family_8[] = {"8XY0", "8XY1", "8XY2", "8XY3", "8XY4", "8XY5", "8XY6", "8XY7",
+                                           "8XY8", "8XY9", "8XYA", "8XYB", "8XYC", "8XYD", "8XYE", "8XYF"};
+    static char const* const family_e[] = {"EX9E", "EXA1", "EXNN"};
+    static char const* const family_f[] = {"FX07", "FX0A", "FX15", "FX18", "FX1E", "FX29", "FX33", "FX55",
+                                           "FX65", "FXNN", "FN01", "FX30"};
+    static char const* const single[] = {nullptr, "1NNN", "2NNN", "3XNN", "4XNN", "5XY0", "6XNN", "7XNN",
+                                         nullptr, "9XY0", "ANNN", "BNNN", "CXNN", "DXYN", nullptr, nullptr};
+
+    uint8_t family = slot >> 4, sub = slot & 0xF;
+    switch (family) {
+    case 0x0:   return sub < 10 ? family_0[sub] : nullptr;
+    case 0x8:   return family_8[sub];
+    case 0xE:   return sub < 3 ? family_e[sub] : nullptr;
+    case 0xF:   return sub < 12 ? family_f[sub] : nullptr;
+    default:    return sub == 0 ? single[family] : nullptr;
+    }
+}
+
+void dump_at_exit() {
+    if (!dump_path.empty() && stats_dump(dump_path.c_str()))
+        std::fprintf(stderr, "error: could not write stats to %s\n", dump_path.c_str());
+}
+
+}
+
+StatCounters& stat_register() {
+    thread_local ThreadCounters mine;
+    stat_local = &mine.counters;
+    return mine.counters;
+}
+
+void stat_frame_time(uint64_t ns) {
+    StatCounters& counters = stat_counters();
+    int bucket = std::min<int>(std::bit_width(ns / 1000), StatCounters::frame_buckets - 1);
+    stat_add(counters.frames, 1);
+    stat_add(counters.frame_us[bucket], 1);
+}
+
+
+//////////////////////////////////////////////////
+//                     Dump                     //
+//////////////////////////////////////////////////
+
+int stats_dump(char const* path) {
+    StatCounters total{};
+    {
+        std::lock_guard<std::mutex> guard(registry_lock);
+        add_into(total, retired);
+        for (StatCounters* counters : live)
+            add_into(total, *counters);
+    }
+
+    std::FILE* out = std::fopen(path, "w");
+    if (!out)
+        return 1;
+
+    uint64_t instructions = 0;
+    for (auto& count : total.ops)
+        instructions += count.load(std::memory_order_relaxed);
+
+    std::fprintf(out, "{\n  \"instructions\": %llu,\n  \"opcodes\": {", (unsigned long long)instructions);
+    bool first = true;
+    for (int slot=0; slot<256; slot++) {
+        uint64_t count = total.ops[slot].load(std::memory_order_relaxed);
+        if (count == 0 || !slot_name(slot))
+            continue;
+        std::fprintf(out, "%s\n    \"%s\": %llu", first ? "" : ",", slot_name(slot), (unsigned long long)count);
+        first = false;
+    }
+
+    std::fprintf(out, "\n  },\n  \"draws\": %llu,\n  \"collisions\": %llu,\n  \"max_stack_depth\": %llu,\n",
+                 (unsigned long long)total.draws.load(std::memory_order_relaxed),
+                 (unsigned long long)total.collisions.load(std::memory_order_relaxed),
+                 (unsigned long long)total.max_stack_depth.load(std::memory_order_relaxed));
+
+    // bucket n holds frames that took [2^(n-1), 2^n) microseconds, the last one everything longer
+    std::fprintf(out, "  \"frames\": %llu,\n  \"frame_time_us\": {",
+                 (unsigned long long)total.frames.load(std::memory_order_relaxed));
+    first = true;
+    for (int b=0; b<StatCounters::frame_buckets; b++) {
+        uint64_t count = total.frame_us[b].load(std::memory_order_relaxed);
+        if (count == 0)
+            continue;
+        if (b + 1 < StatCounters::frame_buckets)
+            std::fprintf(out, "%s\n    \"<%llu\": %llu", first ? "" : ",", 1ull << b, (unsigned long long)count);
+        else
+            std::fprintf(out, "%s\n    \">=%llu\": %llu", first ? "" : ",", 1ull << (b - 1), (unsigned long long)count);
+        first = false;
+    }
+    std::fprintf(out, "\n  }\n}\n");
+
+    return std::fclose(out) == 0 ? 0 : 1;
+}
+
+void stats_install(char const* path) {
+    if (!path)
+        return;
+
+    dump_path = path;
+    std::atexit(dump_at_exit);
+
+    // SIGUSR1 is blocked here & in every thread started after this, so only
+    // the dumper ever takes it - no file I/O happens in a signal handler
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGUSR1);
+    pthread_sigmask(SIG_BLOCK, &set, nullptr);
+
+    std::thread([set] {
+        int sig;
+        while (sigwait(&set, &sig) == 0) {
+            if (stats_dump(dump_path.c_str()))
+                std::fprintf(stderr, "error: could not write stats to %s\n", dump_path.c_str());
+        }
+    }).detach();
+}
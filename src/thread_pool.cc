@@ -0,0 +1,143 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <algorithm>
+
+#include "thread_pool.hh"
+
+WorkStealingPool::WorkStealingPool(unsigned threads)
+    : next_queue(0), queued(0), pending(0), stopping(false)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned i=0; i<threads; i++)
+        queues.push_back(std::make_unique<Queue>());
+
+    // queues must all exist before any worker goes looking to steal
+    for (unsigned i=0; i<threads; i++)
+        workers.emplace_back(&WorkStealingPool::worker_loop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> guard(idle_lock);
+        stopping = true;
+    }
+    work_ready.notify_all();
+
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+size_t WorkStealingPool::size() const {
+    return workers.size();
+}
+
+
+//////////////////////////////////////////////////
+//                    Tasks                     //
+//////////////////////////////////////////////////
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    pending.fetch_add(1, std::memory_order_relaxed);
+
+    // counted before it's pushed, so a worker that takes it straight away
+    // never takes queued below 0 - & under idle_lock so a worker can't
+    // check, miss it, then sleep
+    {
+        std::lock_guard<std::mutex> guard(idle_lock);
+        queued.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Queue& queue = *queues[next_queue];
+    next_queue = (next_queue + 1) % queues.size();
+    {
+        std::lock_guard<std::mutex> guard(queue.lock);
+        queue.tasks.push_back(std::move(task));
+    }
+    work_ready.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> guard(idle_lock);
+    all_done.wait(guard, [this] { return pending.load(std::memory_order_acquire) == 0; });
+}
+
+// own queue first (newest task, still warm in cache), then the oldest task
+// of each other queue in turn
+bool WorkStealingPool::take(size_t self, std::function<void()>& task) {
+    for (size_t i=0; i<queues.size(); i++) {
+        Queue& queue = *queues[(self + i) % queues.size()];
+
+        std::lock_guard<std::mutex> guard(queue.lock);
+        if (queue.tasks.empty())
+            continue;
+
+        if (i == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+
+//////////////////////////////////////////////////
+//                   Workers                    //
+//////////////////////////////////////////////////
+
+void WorkStealingPool::worker_loop(size_t self) {
+    std::function<void()> task;
+
+    while (true) {
+        if (take(self, task)) {
+            task();
+            task = nullptr;
+
+            if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> guard(idle_lock);
+                all_done.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(idle_lock);
+        work_ready.wait(guard, [this] {
+            return stopping || queued.load(std::memory_order_relaxed) > 0;
+        });
+        if (stopping && queued.load(std::memory_order_relaxed) == 0)
+            return;
+    }
+}
@@ -33,15 +33,19 @@ freely, subject to the following restrictions:
 #include "SDL3/SDL_messagebox.h"
 #include "SDL3/SDL_pixels.h"
 #include "SDL3/SDL_dialog.h"
-#include <iostream>
+#include "SDL3/SDL_timer.h"
+#include <algorithm>
+
+#include "log.hh"
 
 WindowHandler::WindowHandler() {
     SDL_Init(SDL_INIT_VIDEO);
 
     is_running = true;
 
+    title = "Chip8";
     window = SDL_CreateWindow(
-        "Chip8",
+        title.c_str(),
         1024,
         512,
         0
@@ -53,21 +57,24 @@ WindowHandler::WindowHandler() {
     texture = SDL_CreateTexture(
         renderer,
         SDL_PIXELFORMAT_RGBA8888,
-        SDL_TEXTUREACCESS_TARGET,
-        64,
-        32
+        SDL_TEXTUREACCESS_STREAMING,
+        Screen::max_width,
+        Screen::max_height
     );
 
     // texture scale mode (nearest pixel mode, don't blur pixels)
     SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
 
-    SDL_SetRenderTarget(renderer, texture);
-    SDL_RenderClear(renderer);
-    SDL_SetRenderTarget(renderer, NULL);
+    repaint = false;
+    hires = false;
+    std::fill(pixels.begin(), pixels.end(), palette.bg);
+    SDL_UpdateTexture(texture, NULL, pixels.data(), Screen::max_width * sizeof(uint32_t));
 
     // initialize keys (unpressed)
-    std::fill(keys.begin(), keys.end(), false);
+    keys = 0;
     last_key_down = -1;
+    rewind_held = false;
+    turbo_held = false;
 }
 
 WindowHandler::~WindowHandler() {
@@ -77,38 +84,73 @@ WindowHandler::~WindowHandler() {
     SDL_Quit();
 }
 
-void WindowHandler::draw_pixels(std::array<uint64_t, 32> chip8_display) {
-    std::array<uint32_t, 2048> display_texture;
-    std::array<uint32_t, 2048>::iterator display_pixel = display_texture.begin();
+void WindowHandler::draw_pixels(const Screen& chip8_display, uint64_t dirty_rows) {
+    if (repaint || chip8_display.hires != hires) {
+        dirty_rows = all_rows;
+        hires = chip8_display.hires;
+        repaint = false;
+    }
 
-    for (uint64_t row : chip8_display) {
-        for (uint64_t mask = 0x8000000000000000; mask > 0; mask >>= 1) {
-            // check current display pixel, convert to appropriate texture pixel to match
-            *(display_pixel++) = ((row & mask) > 0) ? 0xFFFFFFFF : 0x000000FF;
-        }
+    // re-expand only the rows that changed
+    constexpr int width = Screen::max_width;
+    int height = chip8_display.height();
+    int first = height;
+    int last = -1;
+    for (int y=0; y<height; y++) {
+        if (!(dirty_rows & (uint64_t(1) << y)))
+            continue;
+
+        expand_planes(chip8_display.planes[0][y].data(), chip8_display.planes[1][y].data(), width, 1,
+                      &pixels[y * width], palette);
+        first = std::min(first, y);
+        last = y;
     }
+    if (last < 0)
+        return;
 
+    // upload just the band of rows that changed
+    SDL_Rect band{0, first, width, last - first + 1};
     SDL_UpdateTexture(
         texture,
-        NULL,
-        display_texture.data(),
-        64 * sizeof(uint32_t)
+        &band,
+        &pixels[first * width],
+        width * sizeof(uint32_t)
     );
+
+    // only the part of the texture the current resolution covers is shown
+    SDL_FRect shown{0, 0, float(chip8_display.width()), float(height)};
     SDL_RenderTexture(
         renderer,
         texture,
-        NULL,
+        &shown,
         NULL);
     SDL_RenderPresent(renderer);
 }
 
+void WindowHandler::set_palette(Palette new_palette) {
+    palette = new_palette;
+    repaint = true;
+}
+
 void WindowHandler::poll_events() {
+    // event timestamps are SDL_GetTicksNS() time, the emulation thread works in steady_clock time
+    int64_t clock_offset = int64_t(input_clock_ns()) - int64_t(SDL_GetTicksNS());
+
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
         if (event.type == SDL_EVENT_QUIT) {
             is_running = false;
         }
         else if (event.type == SDL_EVENT_KEY_UP || event.type == SDL_EVENT_KEY_DOWN) {
+            if (event.key.key == SDLK_BACKSPACE) {
+                rewind_held = (event.type == SDL_EVENT_KEY_DOWN);
+                continue;
+            }
+            if (event.key.key == SDLK_TAB) {
+                turbo_held = (event.type == SDL_EVENT_KEY_DOWN);
+                continue;
+            }
+
             int selected_key = -1;
             switch (event.key.key) {
             case SDLK_1:    selected_key = 1;       break;
@@ -129,29 +171,72 @@ void WindowHandler::poll_events() {
             case SDLK_V:    selected_key = 15;      break;
             }
             if (selected_key >= 0) {
-                if (event.type == SDL_EVENT_KEY_DOWN) {
-                    keys[selected_key] = true;
+                bool down = (event.type == SDL_EVENT_KEY_DOWN);
+                if (down && event.key.repeat)
+                    continue;
+                uint64_t time_ns = uint64_t(int64_t(event.key.timestamp) + clock_offset);
+                if (!input_queue.push(InputEvent{time_ns, uint8_t(selected_key), down}))
+                    CHIP8_LOG(Warn, "input queue full, key {} event lost", selected_key);
+
+                if (down) {
+                    keys |= 1 << selected_key;
                     last_key_down = selected_key;
+                    CHIP8_LOG(Debug, "key {} down", selected_key);
                 }
                 else { // key up event
-                    keys[selected_key] = false;
+                    keys &= ~(1 << selected_key);
                     last_key_down = -1;
+                    CHIP8_LOG(Debug, "key {} up", selected_key);
                 }
             }
-            std::cout << "Last down: " << last_key_down << " - " << keys[last_key_down] << "\n";
         }
     }
 }
 
+void WindowHandler::wait_events(int timeout_ms) {
+    SDL_WaitEventTimeout(NULL, timeout_ms);
+    poll_events();
+}
+
+bool WindowHandler::key_is_pressed(uint8_t key) {
+    return keys.load(std::memory_order_relaxed) & (1 << (key & 0xF));
+}
+
+int WindowHandler::get_curr_key() {
+    int key = last_key_down.load(std::memory_order_relaxed);
+    if (key >= 0 && key_is_pressed(key))
+        return key;
+    return -1;
+}
+
 void WindowHandler::popup(std::string title, std::string message) {
     SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, title.c_str(), message.c_str(), window);
     is_running = false;
 }
 
+InputQueue& WindowHandler::get_input_queue() {
+    return input_queue;
+}
+
 bool WindowHandler::get_run_status() {
     return is_running;
 }
 
+bool WindowHandler::rewind_is_held() {
+    return rewind_held;
+}
+
+bool WindowHandler::turbo_is_held() {
+    return turbo_held;
+}
+
+void WindowHandler::set_title(const std::string& new_title) {
+    if (new_title == title)
+        return;
+    title = new_title;
+    SDL_SetWindowTitle(window, title.c_str());
+}
+
 void WindowHandler::open_file() {
     SDL_ShowOpenFileDialog(
         [](void* userdata, const char* const* filelist, int filter) {
@@ -0,0 +1,135 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "chip8.hh"
+#include "cli.hh"
+#include "engine.hh"
+#include "headless.hh"
+#include "lockstep.hh"
+#include "quirks.hh"
+#include "savestate.hh"
+#include "scheduler.hh"
+#include "random_rom.hh"
+
+// Differential test - random programs (random_rom.hh) under random quirks run
+// for a number of frames through every engine built in & through Lockstep
+// lanes, each lane with its own seed & keys. Every run has to end in the same
+// SaveState, byte for byte, as the switch engine's. The programs are classic
+// CHIP-8 only, so no lane ever stops unsupported.
+//
+// usage: chip8-test-engines [roms]
+
+static constexpr char const* engines[] = {"dispatch", "jit"};
+static constexpr size_t lanes = 4;
+static constexpr uint64_t frames = 30;
+
+// keys held in frame f of lane l - the same pattern for every run of the lane
+static uint16_t lane_keys(size_t lane, uint64_t frame, uint64_t rom_seed) {
+    uint64_t state = rom_seed ^ (lane << 32) ^ frame;
+    uint64_t r = next_random(state);
+    return uint16_t(r) & uint16_t(r >> 16);
+}
+
+static void run_engine(char const* name, Chip8& chip8, size_t lane, uint64_t rom_seed) {
+    HeadlessFrontend io{};
+    std::unique_ptr<Engine> engine = make_engine(name, chip8, io);
+    Scheduler scheduler(chip8, *engine, io);
+    for (uint64_t f=0; f<frames; f++) {
+        io.set_keys(lane_keys(lane, f, rom_seed));
+        scheduler.run_frame();
+    }
+}
+
+int main(int argc, char ** argv) {
+    uint64_t roms = 200;
+    if (argc > 2 || (argc > 1 && !parse_count(argv[1], roms))) {
+        std::fprintf(stderr, "usage: %s [roms]\n", argv[0]);
+        return 1;
+    }
+
+    int failures = 0;
+    for (uint64_t rom_seed=1; rom_seed<=roms; rom_seed++) {
+        Chip8 start(random_rom(rom_seed));
+        start.config_quirk_bits(rom_seed & 7);
+        start.config_timing(60000);     // 1000 instructions a frame
+
+        SaveState initial;
+        start.save(initial);
+        Lockstep lockstep(initial, lanes);
+        for (size_t l=0; l<lanes; l++)
+            lockstep.seed_rand(l, rom_seed + l);
+        for (uint64_t f=0; f<frames; f++) {
+            for (size_t l=0; l<lanes; l++)
+                lockstep.set_keys(l, lane_keys(l, f, rom_seed));
+            lockstep.run_frame();
+        }
+
+        for (size_t l=0; l<lanes; l++) {
+            Chip8 reference = start.clone();
+            reference.seed_rand(rom_seed + l);
+            run_engine("switch", reference, l, rom_seed);
+            SaveState expect;
+            reference.save(expect);
+
+            for (char const* name : engines) {
+                if (!has_engine(name))
+                    continue;
+                Chip8 chip8 = start.clone();
+                chip8.seed_rand(rom_seed + l);
+                run_engine(name, chip8, l, rom_seed);
+
+                SaveState got;
+                chip8.save(got);
+                if (std::memcmp(&expect, &got, sizeof(SaveState)) != 0 && failures++ < 10)
+                    std::printf("FAIL rom %llu lane %zu: %s ends at pc %03X, switch at %03X\n",
+                                (unsigned long long)rom_seed, l, name, got.program_counter,
+                                expect.program_counter);
+            }
+
+            SaveState got;
+            lockstep.save_lane(l, got);
+            if (std::memcmp(&expect, &got, sizeof(SaveState)) != 0 && failures++ < 10)
+                std::printf("FAIL rom %llu lane %zu: lockstep ends at pc %03X, switch at %03X\n",
+                            (unsigned long long)rom_seed, l, got.program_counter, expect.program_counter);
+        }
+    }
+
+    if (failures) {
+        std::printf("%d runs differ\n", failures);
+        return 1;
+    }
+    std::printf("%llu roms x %zu lanes x %llu frames, every engine matches switch\n",
+                (unsigned long long)roms, lanes, (unsigned long long)frames);
+    return 0;
+}
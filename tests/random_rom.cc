@@ -0,0 +1,196 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <cstddef>
+
+#include "random_rom.hh"
+
+uint64_t next_random(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
+}
+
+namespace {
+
+// a run of instructions under construction - keeps track of which ones a
+// jump may land on, & where the calls & forward jumps to patch are once the
+// layout is known
+struct Block {
+    std::vector<uint16_t> code;
+    std::vector<bool> landable;
+    std::vector<size_t> calls;
+    std::vector<size_t> jumps;
+    bool after_skip = false;
+
+    void emit(uint16_t inst, bool land = true) {
+        code.push_back(inst);
+        landable.push_back(land);
+    }
+};
+
+// one random item - an instruction, or an ANNN + store pair
+void random_item(Block& block, uint64_t& rng, bool last, bool in_main) {
+    uint64_t r = next_random(rng);
+    uint16_t x = (r >> 8) & 0xF;
+    uint16_t y = (r >> 12) & 0xF;
+    uint16_t nn = (r >> 16) & 0xFF;
+    uint16_t nnn = 0x200 + ((r >> 24) % 0xE00);
+    uint16_t data = 0x600 + ((r >> 36) & 0x1F0);
+    static constexpr uint16_t alu_ops[] = {0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0xE};
+
+    bool skip = false;
+    switch (r % 32) {
+    case 0: case 1: case 2:
+        block.emit(0x6000 | x << 8 | nn);
+        break;
+    case 3: case 4: case 5:
+        block.emit(0x7000 | x << 8 | nn);
+        break;
+    case 6: case 7: case 8: case 9: case 10:
+        block.emit(0x8000 | x << 8 | y << 4 | alu_ops[(r >> 40) % 9]);
+        break;
+    case 11:
+        block.emit(0xC000 | x << 8 | nn);
+        break;
+    case 12: case 13: case 14: case 15:
+        skip = true;
+        switch ((r >> 40) % 6) {
+        case 0: block.emit(0x3000 | x << 8 | nn); break;
+        case 1: block.emit(0x4000 | x << 8 | nn); break;
+        case 2: block.emit(0x5000 | x << 8 | y << 4); break;
+        case 3: block.emit(0x9000 | x << 8 | y << 4); break;
+        case 4: block.emit(0xE09E | x << 8); break;
+        case 5: block.emit(0xE0A1 | x << 8); break;
+        }
+        break;
+    case 16: case 17:
+        block.emit(0xA000 | nnn);
+        break;
+    case 18: case 19: case 20:
+        block.emit(0xD000 | x << 8 | y << 4 | (nn & 0xF));
+        break;
+    case 21:
+        block.emit(0x00E0);
+        break;
+    case 22:
+        block.emit(0xF007 | x << 8);
+        break;
+    case 23:
+        block.emit(((r >> 40) & 1 ? 0xF015 : 0xF018) | x << 8);
+        break;
+    case 24:
+        block.emit(0xF01E | x << 8);
+        break;
+    case 25:
+        block.emit(0xF029 | x << 8);
+        break;
+    case 26:
+        block.emit(0xF065 | x << 8);
+        break;
+    case 27: case 28:
+        // skipping the ANNN would store wherever I points - maybe into code
+        if (block.after_skip) {
+            block.emit(0x7000 | x << 8 | nn);
+            break;
+        }
+        block.emit(0xA000 | data);
+        block.emit(((r >> 40) & 1 ? 0xF033 : 0xF055) | x << 8, false);
+        break;
+    case 29:
+        if (in_main) {
+            block.calls.push_back(block.code.size());
+            block.emit(0x2000);
+            break;
+        }
+        block.emit(0x6000 | x << 8 | nn);
+        break;
+    case 30:
+        if (in_main) {
+            block.jumps.push_back(block.code.size());
+            block.emit(0x1000);
+            break;
+        }
+        block.emit(0x8000 | x << 8 | y << 4);
+        break;
+    case 31:
+        // rare, so a program waiting on a key that stays up doesn't stall every run
+        if ((r >> 40) % 4 == 0)
+            block.emit(0xF00A | x << 8);
+        else
+            block.emit(0xF029 | x << 8);
+        break;
+    }
+
+    // a skip as the last item would skip the jump back / the return
+    if (skip && last)
+        block.code.back() = 0x6000 | x << 8 | nn;
+    block.after_skip = skip && !last;
+}
+
+} // namespace
+
+std::vector<uint8_t> random_rom(uint64_t seed) {
+    uint64_t rng = seed;
+    size_t main_items = 24 + next_random(rng) % 40;
+    size_t sub_items = 4 + next_random(rng) % 8;
+
+    // the subroutine goes right after the main loop
+    Block sub;
+    for (size_t i=0; i<sub_items; i++)
+        random_item(sub, rng, i + 1 == sub_items, false);
+    sub.emit(0x00EE);
+
+    Block main;
+    for (size_t i=0; i<main_items; i++)
+        random_item(main, rng, i + 1 == main_items, true);
+    main.emit(0x1200);
+
+    uint16_t sub_start = 0x200 + 2 * main.code.size();
+    for (size_t at : main.calls)
+        main.code[at] = 0x2000 | sub_start;
+
+    // forward jumps land on any instruction after them, or the jump back
+    for (size_t at : main.jumps) {
+        size_t target;
+        do {
+            target = at + 1 + next_random(rng) % (main.code.size() - at - 1);
+        } while (!main.landable[target]);
+        main.code[at] = 0x1000 | (0x200 + 2 * target);
+    }
+
+    std::vector<uint8_t> rom;
+    for (const Block* block : {&main, &sub}) {
+        for (uint16_t inst : block->code) {
+            rom.push_back(inst >> 8);
+            rom.push_back(inst & 0xFF);
+        }
+    }
+    return rom;
+}
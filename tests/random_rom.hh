@@ -0,0 +1,43 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Random classic CHIP-8 programs for the tests. Each is a main loop of random
+// instructions at 0x200 - ALU ops, skips, draws, timers, keys, random numbers,
+// forward jumps & calls into one subroutine - that jumps back to 0x200 forever.
+// Stores (FX33 / FX55) always follow an ANNN into 0x600-0x7FF, so programs
+// never overwrite themselves, and every op is one all engines & Lockstep
+// lanes run. The same seed gives the same program.
+std::vector<uint8_t> random_rom(uint64_t);
+
+// splitmix64 step - for anything else a test needs at random
+uint64_t next_random(uint64_t&);
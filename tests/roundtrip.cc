@@ -0,0 +1,228 @@
+/*
+CREDITS:
+
+This software makes use of
+- SDL3
+- tinyfiledialogs
+
+------------------------------------------------------------------------------
+zlib License
+
+(C) 2025 Ryan Nuppenau
+
+This software is provided 'as-is', without any express or implied
+warranty.  In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "chip8.hh"
+#include "engine.hh"
+#include "headless.hh"
+#include "movie.hh"
+#include "rewind.hh"
+#include "savestate.hh"
+#include "scheduler.hh"
+#include "random_rom.hh"
+
+// Round trips - a run that goes through a save state file, rewinds, or is
+// recorded & replayed as a movie has to end exactly where the same run
+// without any of that does. Random programs (random_rom.hh) with random keys.
+//
+// usage: chip8-test-roundtrip
+
+static constexpr uint64_t roms = 20;
+static constexpr uint64_t frames = 120;
+
+static uint16_t frame_keys(uint64_t rom_seed, uint64_t frame) {
+    uint64_t state = rom_seed << 32 ^ frame;
+    uint64_t r = next_random(state);
+    return uint16_t(r) & uint16_t(r >> 16);
+}
+
+static Chip8 power_on(uint64_t rom_seed) {
+    Chip8 chip8(random_rom(rom_seed));
+    chip8.config_quirk_bits(rom_seed & 7);
+    chip8.config_timing(60000);     // 1000 instructions a frame
+    chip8.seed_rand(rom_seed);
+    return chip8;
+}
+
+// frames first to first + count - 1, each with its own keys
+static void run_frames(Chip8& chip8, uint64_t rom_seed, uint64_t first, uint64_t count) {
+    HeadlessFrontend io{};
+    std::unique_ptr<Engine> engine = make_engine("dispatch", chip8, io);
+    Scheduler scheduler(chip8, *engine, io);
+    for (uint64_t f=first; f<first + count; f++) {
+        io.set_keys(frame_keys(rom_seed, f));
+        scheduler.run_frame();
+    }
+}
+
+static bool same(Chip8& chip8, const SaveState& expect) {
+    SaveState got;
+    chip8.save(got);
+    return std::memcmp(&got, &expect, sizeof(SaveState)) == 0;
+}
+
+// stop halfway, write the state out, read it into a machine that has been
+// running something else & carry on there
+static bool check_save_state(uint64_t rom_seed, const SaveState& expect, const std::filesystem::path& path) {
+    Chip8 first = power_on(rom_seed);
+    run_frames(first, rom_seed, 0, frames / 2);
+    SaveState saved;
+    first.save(saved);
+    if (write_state_file(path, saved)) {
+        std::printf("FAIL rom %llu: can't write %s\n", (unsigned long long)rom_seed, path.c_str());
+        return false;
+    }
+
+    Chip8 second = power_on(rom_seed + 1);
+    run_frames(second, rom_seed + 1, 0, 10);
+    SaveState loaded;
+    if (read_state_file(path, loaded) || second.load(loaded)) {
+        std::printf("FAIL rom %llu: can't read back the save state\n", (unsigned long long)rom_seed);
+        return false;
+    }
+    run_frames(second, rom_seed, frames / 2, frames - frames / 2);
+    if (!same(second, expect)) {
+        std::printf("FAIL rom %llu: run through a save state differs\n", (unsigned long long)rom_seed);
+        return false;
+    }
+    return true;
+}
+
+// every frame stepped back to has to be the state that frame ended in, and
+// running on from one has to retrace the same frames
+static bool check_rewind(uint64_t rom_seed) {
+    Chip8 chip8 = power_on(rom_seed);
+    Rewind rewind(1 << 20);
+    std::vector<SaveState> history(frames);
+
+    HeadlessFrontend io{};
+    std::unique_ptr<Engine> engine = make_engine("dispatch", chip8, io);
+    Scheduler scheduler(chip8, *engine, io);
+    for (uint64_t f=0; f<frames; f++) {
+        io.set_keys(frame_keys(rom_seed, f));
+        scheduler.run_frame();
+        chip8.save(history[f]);
+        rewind.push(history[f]);
+    }
+
+    uint64_t back = frames / 2;
+    SaveState state;
+    for (uint64_t f=frames - 1; f-- > frames - 1 - back;) {
+        if (!rewind.step_back(state) || std::memcmp(&state, &history[f], sizeof(SaveState)) != 0) {
+            std::printf("FAIL rom %llu: rewound to frame %llu wrong\n", (unsigned long long)rom_seed,
+                        (unsigned long long)f);
+            return false;
+        }
+    }
+
+    // same engine, as the emulation thread does it
+    chip8.load(state);
+    for (uint64_t f=frames - back; f<frames; f++) {
+        io.set_keys(frame_keys(rom_seed, f));
+        scheduler.run_frame();
+    }
+    if (!same(chip8, history[frames - 1])) {
+        std::printf("FAIL rom %llu: run on from a rewind differs\n", (unsigned long long)rom_seed);
+        return false;
+    }
+    return true;
+}
+
+// record the keys, then replay them on a machine configured only by the movie
+static bool check_movie(uint64_t rom_seed, const std::filesystem::path& path) {
+    Chip8 recorded(random_rom(rom_seed));
+    recorded.config_quirk_bits(rom_seed & 7);
+    recorded.config_timing(60000);
+    MovieWriter writer;
+    if (writer.open(path, make_movie_header(recorded, rom_seed))) {
+        std::printf("FAIL rom %llu: can't write %s\n", (unsigned long long)rom_seed, path.c_str());
+        return false;
+    }
+    recorded.seed_rand(rom_seed);
+    for (uint64_t f=0; f<frames; f++)
+        writer.record(frame_keys(rom_seed, f));
+    if (writer.close()) {
+        std::printf("FAIL rom %llu: can't finish %s\n", (unsigned long long)rom_seed, path.c_str());
+        return false;
+    }
+    run_frames(recorded, rom_seed, 0, frames);
+    SaveState expect;
+    recorded.save(expect);
+
+    Chip8 played(random_rom(rom_seed));
+    MovieReader reader;
+    if (reader.open(path) || start_movie(played, reader.get_header())) {
+        std::printf("FAIL rom %llu: can't play back the movie\n", (unsigned long long)rom_seed);
+        return false;
+    }
+    HeadlessFrontend io{};
+    std::unique_ptr<Engine> engine = make_engine("dispatch", played, io);
+    Scheduler scheduler(played, *engine, io);
+    uint16_t keys;
+    while (reader.next(keys)) {
+        io.set_keys(keys);
+        scheduler.run_frame();
+    }
+    if (scheduler.get_frame_count() != frames || !same(played, expect)) {
+        std::printf("FAIL rom %llu: replayed movie differs (%llu of %llu frames)\n", (unsigned long long)rom_seed,
+                    (unsigned long long)scheduler.get_frame_count(), (unsigned long long)frames);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char ** argv) {
+    if (argc > 1) {
+        std::fprintf(stderr, "usage: %s\n", argv[0]);
+        return 1;
+    }
+
+    std::filesystem::path dir = std::filesystem::temp_directory_path();
+    std::filesystem::path state_path = dir / "chip8-test-roundtrip.c8s";
+    std::filesystem::path movie_path = dir / "chip8-test-roundtrip.c8m";
+
+    int failures = 0;
+    for (uint64_t rom_seed=1; rom_seed<=roms; rom_seed++) {
+        Chip8 chip8 = power_on(rom_seed);
+        run_frames(chip8, rom_seed, 0, frames);
+        SaveState expect;
+        chip8.save(expect);
+
+        failures += !check_save_state(rom_seed, expect, state_path);
+        failures += !check_rewind(rom_seed);
+        failures += !check_movie(rom_seed, movie_path);
+    }
+
+    std::error_code ignored;
+    std::filesystem::remove(state_path, ignored);
+    std::filesystem::remove(movie_path, ignored);
+
+    if (failures) {
+        std::printf("%d round trips differ\n", failures);
+        return 1;
+    }
+    std::printf("%llu roms x %llu frames, save states, rewind & movies all match\n", (unsigned long long)roms,
+                (unsigned long long)frames);
+    return 0;
+}